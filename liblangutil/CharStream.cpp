@@ -53,6 +53,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -81,6 +83,23 @@ char CharStream::setPosition(size_t _location)
 	return get();
 }
 
+shared_ptr<vector<size_t> const> CharStream::lineStarts() const
+{
+	// Atomic access, so that lookups from different threads are safe (at worst the index is built twice)
+	auto index = atomic_load(&m_lineStarts);
+	if (!index)
+	{
+		auto starts = make_shared<vector<size_t>>();
+		starts->push_back(0);
+		for (size_t i = 0; i < m_source.size(); ++i)
+			if (m_source[i] == '\n')
+				starts->push_back(i + 1);
+		index = move(starts);
+		atomic_store(&m_lineStarts, index);
+	}
+	return index;
+}
+
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
@@ -88,11 +107,9 @@ string CharStream::lineAtPosition(int _position) const
 	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
+	// Last line start at or before the one following searchStart
+	auto starts = lineStarts();
+	size_type lineStart = *prev(upper_bound(starts->begin(), starts->end(), searchStart + 1));
 	string line = m_source.substr(
 		lineStart,
 		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
@@ -105,16 +122,9 @@ string CharStream::lineAtPosition(int _position) const
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
-	using diff_type = string::difference_type;
 	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	auto starts = lineStarts();
+	auto lineStart = prev(upper_bound(starts->begin(), starts->end(), searchPosition));
+	int lineNumber = static_cast<int>(lineStart - starts->begin());
+	return tuple<int, int>(lineNumber, searchPosition - *lineStart);
 }
@@ -53,9 +53,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -92,16 +94,21 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of the line starts, later calls use binary search.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
+	/// @returns the positions where the lines start, builds them on first use.
+	std::shared_ptr<std::vector<size_t> const> lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Sorted positions of the line starts, built lazily. Can be shared by copies, as the source does not change.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -23,6 +23,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -232,6 +233,10 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// Guards the lazily created types, so that types can be created from multiple threads
+	/// (e.g., by the parallel Boogie translation).
+	std::mutex m_mutex;
 };
 
 }
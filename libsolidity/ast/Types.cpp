@@ -45,6 +45,7 @@
 #include <boost/range/algorithm/copy.hpp>
 
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 #include <utility>
 
@@ -237,6 +238,13 @@ StorageOffsets const& MemberList::storageOffsets() const {
 	});
 }
 
+/// Guards the member list caches. Computing the members of a type can require the
+/// members of other types, hence the lock is recursive.
+namespace
+{
+recursive_mutex membersMutex;
+}
+
 /// Helper functions for type identifier
 namespace
 {
@@ -318,6 +326,7 @@ TypePointer Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(membersMutex);
 	if (!m_members[_currentScope])
 	{
 		solAssert(
@@ -62,7 +62,7 @@ void ASTBoogieConverter::createImplicitConstructor(ContractDefinition const& _no
 	constructorPreamble();
 
 	// Print errors related to the function
-	m_context.printErrors(cerr);
+	m_context.printErrors();
 	// Restore error reporter
 	m_context.errorReporter() = originalErrReporter;
 
@@ -324,6 +324,9 @@ void ASTBoogieConverter::processSpecificationExpression(ASTPointer<Expression> e
 	std::vector<std::vector<bg::Binding>> bgQuantifierVars;
 	std::vector<bg::QuantExpr::Quantifier> bgQuantifierType;
 
+	// Name resolution and type checking work on scopes shared with contexts translating in parallel
+	auto scopesLock = m_context.lockScopes();
+
 	DeclarationTypeChecker checker(*m_context.errorReporter(), m_context.evmVersion());
 
 	// Add all the quantified variables to the scope
@@ -364,6 +367,8 @@ void ASTBoogieConverter::processSpecificationExpression(ASTPointer<Expression> e
 	if (!typeChecker.checkTypeRequirements(*m_context.currentSource(), *m_context.currentContract(), *expr))
 		return;
 
+	scopesLock.unlock();
+
 	// Convert all the quantified variables
 	if (specInfo.quantifierList.size() > 0)
 	{
@@ -514,7 +519,7 @@ bool ASTBoogieConverter::parseExpr(string exprStr, ASTNode const& _node, ASTNode
 	}
 
 	// Print errors relating to the expression string
-	m_context.printErrors(cerr);
+	m_context.printErrors();
 
 	// Restore error reporter
 	m_context.errorReporter() = originalErrReporter;
@@ -611,7 +616,7 @@ bool ASTBoogieConverter::parseSpecificationCasesExpr(string exprStr, ASTNode con
 	}
 
 	// Print errors relating to the expression string
-	m_context.printErrors(cerr);
+	m_context.printErrors();
 
 	// Restore error reporter
 	m_context.errorReporter() = originalErrReporter;
@@ -946,15 +951,29 @@ ASTBoogieConverter::ASTBoogieConverter(BoogieContext& context) :
 //         Visitor methods for top-level nodes and declarations
 // ---------------------------------------------------------------------------
 
-bool ASTBoogieConverter::visit(SourceUnit const& _node)
+void ASTBoogieConverter::beginSourceUnit(SourceUnit const& _node)
 {
-	rememberScope(_node);
-
 	m_context.setCurrentSource(&_node);
 
 	// Boogie programs are flat, source units do not appear explicitly
 	m_context.addGlobalComment("\n------- Source: " + *_node.annotation().path + " -------");
-	return true; // Simply apply visitor recursively
+}
+
+void ASTBoogieConverter::convertTopLevelNode(ASTNode const& _node)
+{
+	m_context.resetNextId();
+	m_nextReturnLabelId = 0;
+	_node.accept(*this);
+}
+
+bool ASTBoogieConverter::visit(SourceUnit const& _node)
+{
+	rememberScope(_node);
+
+	beginSourceUnit(_node);
+	for (auto const& node: _node.nodes())
+		convertTopLevelNode(*node);
+	return false;
 }
 
 bool ASTBoogieConverter::visit(PragmaDirective const& _node)
@@ -1210,7 +1229,7 @@ bool ASTBoogieConverter::visit(FunctionDefinition const& _node)
 	processFuncModifiersAndBody();
 
 	// Print errors related to the function
-	m_context.printErrors(cerr);
+	m_context.printErrors();
 
 	// Restore error reporter
 	m_context.errorReporter() = originalErrReporter;
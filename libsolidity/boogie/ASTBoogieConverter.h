@@ -200,6 +200,16 @@ public:
 	 */
 	void convert(ASTNode const& _node) { _node.accept(*this); }
 
+	/** Sets the current source unit and adds its header comment to the Boogie program. */
+	void beginSourceUnit(SourceUnit const& _node);
+
+	/**
+	 * Convert a top-level node of a source unit (contract, struct, etc.). Fresh ids are
+	 * numbered from zero for each top-level node, so that the result does not depend on
+	 * the other nodes, which allows converting them in parallel.
+	 */
+	void convertTopLevelNode(ASTNode const& _node);
+
 	// Top-level nodes
 	bool visit(SourceUnit const& _node) override;
 	bool visit(PragmaDirective const& _node) override;
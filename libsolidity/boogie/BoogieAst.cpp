@@ -5,7 +5,9 @@
 #include <libsolidity/boogie/BoogieAstDecl.h>
 #include <libsolidity/boogie/BoogieAstExpr.h>
 #include <liblangutil/Exceptions.h>
+#include <algorithm>
 #include <iostream>
+#include <streambuf>
 
 namespace boogie {
 
@@ -59,8 +61,17 @@ std::ostream& operator<<(std::ostream& os, Program const& p)
 	return os;
 }
 
+std::string Attr::getStringValue() const
+{
+	for (auto const& v: vals)
+		if (auto str = std::dynamic_pointer_cast<StringLit const>(v))
+			return str->getVal();
+	return "";
+}
+
 void Attr::print(std::ostream& os) const
 {
+	PrintedLines::recordAttr(os, *this);
 	os << "{:" << name;
 	if (vals.size() > 0)
 		print_seq(os, vals, " ", ", ", "");
@@ -95,4 +106,70 @@ void Program::print(std::ostream& os) const
 	os << "\n";
 }
 
+/** Forwards characters to another buffer and counts the lines. */
+class PrintedLines::LineCounter : public std::streambuf {
+	std::streambuf* dest;
+public:
+	size_t line = 1;
+	LineCounter(std::streambuf* d) : dest(d) {}
+protected:
+	int overflow(int c) override
+	{
+		if (c == '\n')
+			line++;
+		return c == traits_type::eof() ? traits_type::not_eof(c) : dest->sputc(traits_type::to_char_type(c));
+	}
+	std::streamsize xsputn(char const* s, std::streamsize n) override
+	{
+		line += static_cast<size_t>(std::count(s, s + n, '\n'));
+		return dest->sputn(s, n);
+	}
+	int sync() override { return dest->pubsync(); }
+};
+
+int PrintedLines::streamIndex()
+{
+	static int const index = std::ios_base::xalloc();
+	return index;
+}
+
+void PrintedLines::print(Program const& p, std::ostream& os)
+{
+	LineCounter lineCounter(os.rdbuf());
+	std::ostream out(&lineCounter);
+	out.pword(streamIndex()) = this;
+	lines.clear();
+	counter = &lineCounter;
+	p.print(out);
+	out.flush();
+	counter = nullptr;
+}
+
+std::vector<Attr const*> const& PrintedLines::attrsAt(size_t line) const
+{
+	static std::vector<Attr const*> const none;
+	if (line == 0 || line > lines.size())
+		return none;
+	return lines[line - 1];
+}
+
+Attr const* PrintedLines::attrAt(size_t line, std::string const& name) const
+{
+	for (auto a: attrsAt(line))
+		if (a->getName() == name)
+			return a;
+	return nullptr;
+}
+
+void PrintedLines::recordAttr(std::ostream& os, Attr const& a)
+{
+	auto printedLines = static_cast<PrintedLines*>(os.pword(streamIndex()));
+	if (!printedLines || !printedLines->counter)
+		return;
+	size_t line = printedLines->counter->line;
+	if (printedLines->lines.size() < line)
+		printedLines->lines.resize(line);
+	printedLines->lines[line - 1].push_back(&a);
+}
+
 }
@@ -27,6 +27,9 @@ public:
 	Attr(std::string n, std::vector<ExprRef> const& vs) : name(n), vals(vs) {}
 	void print(std::ostream& os) const;
 	std::string getName() const { return name; }
+	std::vector<ExprRef> const& getVals() const { return vals; }
+	/** @returns the value of the first string argument, or empty if there is none */
+	std::string getStringValue() const;
 
 	static Ref attr(std::string s);
 	static Ref attr(std::string s, std::string v);
@@ -62,6 +65,28 @@ public:
 	size_t size() { return decls.size(); }
 	bool empty() { return decls.empty(); }
 	DeclarationList& getDeclarations() { return decls; }
+	DeclarationList const& getDeclarations() const { return decls; }
+};
+
+/**
+ * Prints a program and records the attributes printed on each line, so that
+ * messages of the verifier referring to lines of the printed program can be
+ * mapped back without parsing the text again. The recorded attributes point
+ * into the program, which must outlive this object.
+ */
+class PrintedLines {
+	std::vector<std::vector<Attr const*>> lines; // Attributes per line, starting from line 1
+	class LineCounter;
+	LineCounter* counter = nullptr; // Only set while printing
+	static int streamIndex();
+public:
+	void print(Program const& p, std::ostream& os);
+	/** @returns the attributes printed on a line (starting from 1) */
+	std::vector<Attr const*> const& attrsAt(size_t line) const;
+	/** @returns the first attribute with the given name on a line, or null */
+	Attr const* attrAt(size_t line, std::string const& name) const;
+	/** Records an attribute printed to a stream if the stream is printing a program. */
+	static void recordAttr(std::ostream& os, Attr const& a);
 };
 
 template<class T>
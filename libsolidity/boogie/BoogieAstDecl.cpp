@@ -10,7 +10,7 @@
 
 namespace boogie {
 
-unsigned Decl::uniqueId = 0;
+std::atomic<unsigned> Decl::uniqueId{0};
 
 TypeDeclRef Decl::elementarytype(std::string name)
 {
@@ -3,6 +3,7 @@
 //
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -66,7 +67,7 @@ private:
 public:
 	Kind getKind() const { return kind; }
 private:
-	static unsigned uniqueId;
+	static std::atomic<unsigned> uniqueId; // Declarations are created by parallel translation too
 protected:
 	unsigned id;
 	std::string name;
@@ -83,6 +84,7 @@ public:
 	unsigned getId() const { return id; }
 	std::string getName() const { return name; }
 	Expr::Ref getRefTo() const { return Expr::id(name); }
+	std::vector<AttrRef> const& getAttrs() const { return attrs; }
 	void addAttr(AttrRef a) { attrs.push_back(a); }
 	void addAttrs(std::vector<AttrRef> const& ax) { for (auto a: ax) addAttr(a); }
 
@@ -164,6 +166,7 @@ public:
 		: Decl(FUNCTION, n, ax), params(ps), type(t), body(b) {}
 	void print(std::ostream& os) const override;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == FUNCTION; }
+	TypeDeclRef getType() const { return type; }
 };
 
 class VarDecl : public Decl {
@@ -6,10 +6,91 @@
 #include <libsolidity/boogie/BoogieAstExpr.h>
 #include <liblangutil/Exceptions.h>
 #include <sstream>
+#include <array>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 
 namespace boogie {
 
+namespace
+{
+
+/**
+ * Table of the expressions created by the factories, used for hash-consing:
+ * structurally equal expressions are represented by the same object. Only weak
+ * references are kept, expired entries are removed when the table grows.
+ * The table is split into shards by hash, each with its own lock, so that
+ * threads translating in parallel rarely wait for each other.
+ */
+class ExprTable
+{
+public:
+	static ExprTable& instance()
+	{
+		static ExprTable table;
+		return table;
+	}
+
+	Expr::Ref intern(Expr::Ref const& expr)
+	{
+		Shard& shard = m_shards[expr->hash() % shardCount];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto range = shard.exprs.equal_range(expr->hash());
+		for (auto it = range.first; it != range.second; ++it)
+			if (auto existing = it->second.lock())
+				if (existing->kind() == expr->kind() && existing->equals(*expr))
+					return existing;
+
+		if (shard.exprs.size() >= 2 * shard.purgedSize)
+			shard.purge();
+		shard.exprs.emplace(expr->hash(), expr);
+		return expr;
+	}
+
+	std::size_t size()
+	{
+		std::size_t result = 0;
+		for (auto& shard: m_shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.purge();
+			result += shard.exprs.size();
+		}
+		return result;
+	}
+
+private:
+	static std::size_t constexpr shardCount = 64;
+
+	struct Shard
+	{
+		void purge()
+		{
+			for (auto it = exprs.begin(); it != exprs.end(); )
+				if (it->second.expired())
+					it = exprs.erase(it);
+				else
+					++it;
+			purgedSize = std::max<std::size_t>(exprs.size(), 64);
+		}
+
+		std::mutex mutex;
+		std::unordered_multimap<std::size_t, std::weak_ptr<Expr const>> exprs;
+		std::size_t purgedSize = 64; // Size after the last purge
+	};
+
+	std::array<Shard, shardCount> m_shards;
+};
+
+template<typename T, typename... Args>
+Expr::Ref intern(Args&&... args)
+{
+	return ExprTable::instance().intern(std::make_shared<T const>(std::forward<Args>(args)...));
+}
+
+}
+
 void Expr::printSMT2(std::ostream& out) const
 {
 	printBg(out); // By default print Boogie, override if differs
@@ -31,22 +112,22 @@ std::string Expr::toSMT2String() const
 
 Expr::Ref Expr::error()
 {
-	return std::make_shared<ErrorExpr const>();
+	return intern<ErrorExpr>();
 }
 
 Expr::Ref Expr::exists(std::vector<Binding> const& vars, Ref expr)
 {
-	return std::make_shared<QuantExpr const>(QuantExpr::Exists, vars, expr);
+	return intern<QuantExpr>(QuantExpr::Exists, vars, expr);
 }
 
 Expr::Ref Expr::forall(std::vector<Binding> const& vars, Ref expr)
 {
-	return std::make_shared<QuantExpr const>(QuantExpr::Forall, vars, expr);
+	return intern<QuantExpr>(QuantExpr::Forall, vars, expr);
 }
 
 Expr::Ref Expr::and_(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::And, lhs, rhs);
+	return intern<BinExpr>(BinExpr::And, lhs, rhs);
 }
 
 Expr::Ref Expr::and_(std::vector<Expr::Ref> const& exprs)
@@ -61,7 +142,7 @@ Expr::Ref Expr::and_(std::vector<Expr::Ref> const& exprs)
 
 Expr::Ref Expr::or_(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Or, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Or, lhs, rhs);
 }
 
 Expr::Ref Expr::or_(std::vector<Expr::Ref> const& exprs)
@@ -76,7 +157,7 @@ Expr::Ref Expr::or_(std::vector<Expr::Ref> const& exprs)
 
 Expr::Ref Expr::cond(Ref cond, Ref then, Ref else_)
 {
-	return std::make_shared<CondExpr const>(cond, then, else_);
+	return intern<CondExpr>(cond, then, else_);
 }
 
 Expr::Ref Expr::oneOf(std::vector<Expr::Ref> const& exprs)
@@ -95,182 +176,187 @@ Expr::Ref Expr::oneOf(std::vector<Expr::Ref> const& exprs)
 
 Expr::Ref Expr::eq(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Eq, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Eq, lhs, rhs);
 }
 
 Expr::Ref Expr::lt(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Lt, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Lt, lhs, rhs);
 }
 
 Expr::Ref Expr::gt(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Gt, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Gt, lhs, rhs);
 }
 
 Expr::Ref Expr::lte(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Lte, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Lte, lhs, rhs);
 }
 
 Expr::Ref Expr::gte(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Gte, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Gte, lhs, rhs);
 }
 
 Expr::Ref Expr::plus(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Plus, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Plus, lhs, rhs);
 }
 
 Expr::Ref Expr::minus(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Minus, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Minus, lhs, rhs);
 }
 
 Expr::Ref Expr::div(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Div, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Div, lhs, rhs);
 }
 
 Expr::Ref Expr::intdiv(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::IntDiv, lhs, rhs);
+	return intern<BinExpr>(BinExpr::IntDiv, lhs, rhs);
 }
 
 Expr::Ref Expr::times(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Times, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Times, lhs, rhs);
 }
 
 Expr::Ref Expr::mod(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Mod, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Mod, lhs, rhs);
 }
 
 Expr::Ref Expr::exp(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Exp, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Exp, lhs, rhs);
 }
 
 Expr::Ref Expr::fn(std::string f, std::vector<Ref> const& args)
 {
-	return std::make_shared<FunExpr const>(f, args);
+	return intern<FunExpr>(f, args);
 }
 
 Expr::Ref Expr::fn(std::string f, Ref x)
 {
-	return std::make_shared<FunExpr const>(f, std::vector<Ref>{x});
+	return intern<FunExpr>(f, std::vector<Ref>{x});
 }
 
 Expr::Ref Expr::fn(std::string f, Ref x, Ref y)
 {
-	return std::make_shared<FunExpr const>(f, std::vector<Ref>{x, y});
+	return intern<FunExpr>(f, std::vector<Ref>{x, y});
 }
 
 Expr::Ref Expr::fn(std::string f, Ref x, Ref y, Ref z)
 {
-	return std::make_shared<FunExpr const>(f, std::vector<Ref>{x, y, z});
+	return intern<FunExpr>(f, std::vector<Ref>{x, y, z});
 }
 
 Expr::Ref Expr::id(std::string name)
 {
-	return std::make_shared<VarExpr const>(name);
+	return intern<VarExpr>(name);
 }
 
 Expr::Ref Expr::impl(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Imp, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Imp, lhs, rhs);
 }
 
 Expr::Ref Expr::iff(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Iff, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Iff, lhs, rhs);
 }
 
 Expr::Ref Expr::boollit(bool b)
 {
-	return std::make_shared<BoolLit const>(b);
+	return intern<BoolLit>(b);
 }
 
 Expr::Ref Expr::stringlit(std::string str)
 {
-	return std::make_shared<StringLit const>(str);
+	return intern<StringLit>(str);
 }
 
 Expr::Ref Expr::intlit(unsigned long i)
 {
-	return std::make_shared<IntLit const>(i);
+	return intern<IntLit>(i);
 }
 
 Expr::Ref Expr::intlit(long i)
 {
-	return std::make_shared<IntLit const>(i);
+	return intern<IntLit>(i);
 }
 
 Expr::Ref Expr::intlit(bigint i)
 {
-	return std::make_shared<IntLit const>(i);
+	return intern<IntLit>(i);
 }
 
 Expr::Ref Expr::bvlit(std::string value, unsigned width)
 {
-	return std::make_shared<BvLit const>(value, width);
+	return intern<BvLit>(value, width);
 }
 
 Expr::Ref Expr::bvlit(bigint value, unsigned width)
 {
-	return std::make_shared<BvLit const>(value, width);
+	return intern<BvLit>(value, width);
 }
 
 Expr::Ref Expr::neq(Ref lhs, Ref rhs)
 {
-	return std::make_shared<BinExpr const>(BinExpr::Neq, lhs, rhs);
+	return intern<BinExpr>(BinExpr::Neq, lhs, rhs);
 }
 
 Expr::Ref Expr::not_(Ref expr)
 {
-	return std::make_shared<NotExpr const>(expr);
+	return intern<NotExpr>(expr);
 }
 
 Expr::Ref Expr::neg(Ref expr)
 {
-	return std::make_shared<NegExpr const>(expr);
+	return intern<NegExpr>(expr);
 }
 
 Expr::Ref Expr::arrconst(TypeDeclRef arrType, Ref val)
 {
-	return std::make_shared<ArrConstExpr const>(arrType, val);
+	return intern<ArrConstExpr>(arrType, val);
 }
 
 Expr::Ref Expr::arrsel(Ref base, Ref idx)
 {
-	return std::make_shared<ArrSelExpr const>(base, idx);
+	return intern<ArrSelExpr>(base, idx);
 }
 
 Expr::Ref Expr::arrupd(Ref base, Ref idx, Ref val)
 {
-	return std::make_shared<ArrUpdExpr const>(base, idx, val);
+	return intern<ArrUpdExpr>(base, idx, val);
 }
 
 Expr::Ref Expr::dtsel(Ref base, std::string mem, FuncDeclRef constr, DataTypeDeclRef dt)
 {
-	return std::make_shared<DtSelExpr>(base, mem, constr, dt);
+	return intern<DtSelExpr>(base, mem, constr, dt);
 }
 
 Expr::Ref Expr::dtupd(Ref base, std::string mem, Ref val, FuncDeclRef constr, DataTypeDeclRef dt)
 {
-	return std::make_shared<DtUpdExpr>(base, mem, val, constr, dt);
+	return intern<DtUpdExpr>(base, mem, val, constr, dt);
 }
 
 Expr::Ref Expr::old(Ref expr)
 {
-	return std::make_shared<OldExpr const>(expr);
+	return intern<OldExpr>(expr);
 }
 
 Expr::Ref Expr::tuple(std::vector<Ref> const& elems)
 {
-	return std::make_shared<TupleExpr const>(elems);
+	return intern<TupleExpr>(elems);
+}
+
+std::size_t Expr::internedCount()
+{
+	return ExprTable::instance().size();
 }
 
 Expr::Ref Expr::selectToUpdate(Expr::Ref sel, Expr::Ref value)
@@ -510,7 +596,7 @@ Expr::Ref BinExpr::substitute(Expr::Subst const& s) const
 {
 	Ref lhs1 = lhs->substitute(s);
 	Ref rhs1 = rhs->substitute(s);
-	return std::make_shared<BinExpr const>(op, lhs1, rhs1);
+	return intern<BinExpr>(op, lhs1, rhs1);
 }
 
 Expr::Ref CondExpr::substitute(Expr::Subst const& s) const
@@ -518,7 +604,7 @@ Expr::Ref CondExpr::substitute(Expr::Subst const& s) const
 	Ref cond1 = cond->substitute(s);
 	Ref then1 = then->substitute(s);
 	Ref else1 = else_->substitute(s);
-	return std::make_shared<CondExpr const>(cond1, then1, else1);
+	return intern<CondExpr>(cond1, then1, else1);
 }
 
 Expr::Ref FunExpr::substitute(Expr::Subst const& s) const
@@ -526,37 +612,37 @@ Expr::Ref FunExpr::substitute(Expr::Subst const& s) const
 	std::vector<Ref> args1;
 	for (Ref a: args)
 		args1.push_back(a->substitute(s));
-	return std::make_shared<FunExpr const>(fun, args1);
+	return intern<FunExpr>(fun, args1);
 }
 
 Expr::Ref BoolLit::substitute(Expr::Subst const& s) const
 {
 	(void)s;
-	return std::make_shared<BoolLit const>(val);
+	return intern<BoolLit>(val);
 }
 
 Expr::Ref IntLit::substitute(Expr::Subst const& s) const
 {
 	(void)s;
-	return std::make_shared<IntLit const>(val);
+	return intern<IntLit>(val);
 }
 
 Expr::Ref BvLit::substitute(Expr::Subst const& s) const
 {
 	(void)s;
-	return std::make_shared<BvLit const>(val, width);
+	return intern<BvLit>(val, width);
 }
 
 Expr::Ref NegExpr::substitute(Expr::Subst const& s) const
 {
 	Ref expr1 = expr->substitute(s);
-	return std::make_shared<NegExpr const>(expr1);
+	return intern<NegExpr>(expr1);
 }
 
 Expr::Ref NotExpr::substitute(Expr::Subst const& s) const
 {
 	Ref expr1 = expr->substitute(s);
-	return std::make_shared<NotExpr const>(expr1);
+	return intern<NotExpr>(expr1);
 }
 
 Expr::Ref QuantExpr::substitute(Expr::Subst const& s) const
@@ -576,20 +662,20 @@ Expr::Ref QuantExpr::substitute(Expr::Subst const& s) const
 
 	// Substitute the expression
 	Ref expr1 = expr->substitute(s1);
-	return std::make_shared<QuantExpr const>(quant, vars, expr1);
+	return intern<QuantExpr>(quant, vars, expr1);
 }
 
 Expr::Ref ArrConstExpr::substitute(Expr::Subst const& s) const
 {
 	Ref val1 = val->substitute(s);
-	return std::make_shared<ArrConstExpr const>(arrType, val1);
+	return intern<ArrConstExpr>(arrType, val1);
 }
 
 Expr::Ref ArrSelExpr::substitute(Expr::Subst const& s) const
 {
 	Ref base1 = base->substitute(s);
 	Ref idx1 = idx->substitute(s);
-	return std::make_shared<ArrSelExpr const>(base1, idx1);
+	return intern<ArrSelExpr>(base1, idx1);
 }
 
 Expr::Ref ArrUpdExpr::substitute(Expr::Subst const& s) const
@@ -597,7 +683,7 @@ Expr::Ref ArrUpdExpr::substitute(Expr::Subst const& s) const
 	Ref base1 = base->substitute(s);
 	Ref idx1 = idx->substitute(s);
 	Ref val1 = val->substitute(s);
-	return std::make_shared<ArrUpdExpr const>(base1, idx1, val1);
+	return intern<ArrUpdExpr>(base1, idx1, val1);
 }
 
 Expr::Ref VarExpr::substitute(Expr::Subst const& s) const
@@ -606,13 +692,13 @@ Expr::Ref VarExpr::substitute(Expr::Subst const& s) const
 	if (find != s.end())
 		return find->second;
 	else
-		return std::make_shared<VarExpr const>(name);
+		return intern<VarExpr>(name);
 }
 
 Expr::Ref OldExpr::substitute(Expr::Subst const& s) const
 {
 	Ref expr1 = expr->substitute(s);
-	return std::make_shared<OldExpr const>(expr1);
+	return intern<OldExpr>(expr1);
 }
 
 Expr::Ref TupleExpr::substitute(Expr::Subst const& s) const
@@ -620,26 +706,26 @@ Expr::Ref TupleExpr::substitute(Expr::Subst const& s) const
 	std::vector<Ref> es1;
 	for (Ref e: elems)
 		es1.push_back(e->substitute(s));
-	return std::make_shared<TupleExpr const>(es1);
+	return intern<TupleExpr>(es1);
 }
 
 Expr::Ref StringLit::substitute(Expr::Subst const& s) const
 {
 	(void)s;
-	return std::make_shared<StringLit const>(val);
+	return intern<StringLit>(val);
 }
 
 Expr::Ref DtSelExpr::substitute(Expr::Subst const& s) const
 {
 	Ref base1 = base->substitute(s);
-	return std::make_shared<DtSelExpr const>(base1, member, constr, dt);
+	return intern<DtSelExpr>(base1, member, constr, dt);
 }
 
 Expr::Ref DtUpdExpr::substitute(Expr::Subst const& s) const
 {
 	Ref base1 = base->substitute(s);
 	Ref val1 = val->substitute(s);
-	return std::make_shared<DtUpdExpr const>(base1, member, val1, constr, dt);
+	return intern<DtUpdExpr>(base1, member, val1, constr, dt);
 }
 
 //
@@ -799,6 +885,10 @@ struct CmpHelper {
 
 int Expr::cmp(Expr::Ref e1, Expr::Ref e2)
 {
+	// Equal expressions are shared
+	if (e1 == e2)
+		return 0;
+
 	if (e1->kind() != e2->kind())
 		return static_cast<int>(e1->kind()) - static_cast<int>(e2->kind());
 
@@ -1026,4 +1116,129 @@ int Expr::cmp(std::vector<Ref> const& l1, std::vector<Ref> const& l2)
 	return 0;
 }
 
+//
+// Equality of hash-consed expressions
+//
+
+template<typename T>
+struct EqHelper {
+	static T const& cast(Expr const& e)
+	{
+		auto ptr = dynamic_cast<T const*>(&e);
+		solAssert(ptr, "Wrong type");
+		return *ptr;
+	}
+};
+
+bool ErrorExpr::equals(Expr const&) const
+{
+	return true;
+}
+
+bool BinExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<BinExpr>::cast(e);
+	return op == other.op && lhs == other.lhs && rhs == other.rhs;
+}
+
+bool CondExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<CondExpr>::cast(e);
+	return cond == other.cond && then == other.then && else_ == other.else_;
+}
+
+bool FunExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<FunExpr>::cast(e);
+	return fun == other.fun && args == other.args;
+}
+
+bool BoolLit::equals(Expr const& e) const
+{
+	return val == EqHelper<BoolLit>::cast(e).val;
+}
+
+bool IntLit::equals(Expr const& e) const
+{
+	return val == EqHelper<IntLit>::cast(e).val;
+}
+
+bool BvLit::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<BvLit>::cast(e);
+	return width == other.width && val == other.val;
+}
+
+bool StringLit::equals(Expr const& e) const
+{
+	return val == EqHelper<StringLit>::cast(e).val;
+}
+
+bool NegExpr::equals(Expr const& e) const
+{
+	return expr == EqHelper<NegExpr>::cast(e).expr;
+}
+
+bool NotExpr::equals(Expr const& e) const
+{
+	return expr == EqHelper<NotExpr>::cast(e).expr;
+}
+
+bool QuantExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<QuantExpr>::cast(e);
+	if (quant != other.quant || expr != other.expr || vars.size() != other.vars.size())
+		return false;
+	for (size_t i = 0; i < vars.size(); ++ i)
+		if (vars[i].id != other.vars[i].id || vars[i].type != other.vars[i].type)
+			return false;
+	return true;
+}
+
+bool ArrConstExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<ArrConstExpr>::cast(e);
+	return arrType == other.arrType && val == other.val;
+}
+
+bool ArrSelExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<ArrSelExpr>::cast(e);
+	return base == other.base && idx == other.idx;
+}
+
+bool ArrUpdExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<ArrUpdExpr>::cast(e);
+	return base == other.base && idx == other.idx && val == other.val;
+}
+
+bool DtSelExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<DtSelExpr>::cast(e);
+	return base == other.base && member == other.member && constr == other.constr && dt == other.dt;
+}
+
+bool DtUpdExpr::equals(Expr const& e) const
+{
+	auto const& other = EqHelper<DtUpdExpr>::cast(e);
+	return base == other.base && member == other.member && val == other.val &&
+			constr == other.constr && dt == other.dt;
+}
+
+bool VarExpr::equals(Expr const& e) const
+{
+	return name == EqHelper<VarExpr>::cast(e).name;
+}
+
+bool OldExpr::equals(Expr const& e) const
+{
+	return expr == EqHelper<OldExpr>::cast(e).expr;
+}
+
+bool TupleExpr::equals(Expr const& e) const
+{
+	return elems == EqHelper<TupleExpr>::cast(e).elems;
+}
+
 }
@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 #include <libsolutil/Common.h>
+#include <boost/functional/hash.hpp>
 
 namespace boogie
 {
@@ -34,7 +35,10 @@ public:
 	/** Reference to expressions */
 	using Ref = std::shared_ptr<Expr const>;
 
-	/** Comparison for references */
+	/**
+	 * Comparison for references. Expressions are hash-consed by the factory methods,
+	 * so equal expressions are the same object and the comparison stops there.
+	 */
 	struct RefCompare
 	{
 		bool operator() (Ref r1, Ref r2) const
@@ -112,7 +116,16 @@ public:
 
 	bool isError() const { return kind() == Kind::ERROR; }
 
-	/** Comparison of expressions */
+	/** Structural hash of the expression, equal expressions have the same hash */
+	std::size_t hash() const { return m_hash; }
+
+	/**
+	 * Check if the expression is structurally equal to another one of the same kind.
+	 * Subexpressions are compared by identity, as they are already hash-consed.
+	 */
+	virtual bool equals(Expr const& e) const = 0;
+
+	/** Comparison of expressions (structural, but constant time for the same object) */
 	static int cmp(Ref e1, Ref e2);
 	/** Lexicographic comparison of *same size* vectors of expressions */
 	static int cmp(std::vector<Ref> const& l1, std::vector<Ref> const& l2);
@@ -169,6 +182,18 @@ public:
 	static Ref tuple(std::vector<Ref> const& exprs);
 
 	static Ref selectToUpdate(Ref sel, Ref value);
+
+	/** Number of distinct expressions currently alive (shared by all factories) */
+	static std::size_t internedCount();
+
+protected:
+	/** Structural hash, computed by the constructors of the subclasses */
+	std::size_t m_hash = 0;
+
+	void hashIn(Ref const& e) { boost::hash_combine(m_hash, e ? e->hash() : 0); }
+	void hashIn(std::vector<Ref> const& es) { for (auto const& e: es) hashIn(e); }
+	template<typename T>
+	void hashIn(T const& v) { boost::hash_combine(m_hash, v); }
 };
 
 struct Binding
@@ -185,6 +210,7 @@ public:
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(ErrorExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class BinExpr : public Expr
@@ -200,12 +226,18 @@ private:
 	Expr::Ref lhs;
 	Expr::Ref rhs;
 public:
-	BinExpr(BinaryOperator const op, Expr::Ref lhs, Expr::Ref rhs) : op(op), lhs(lhs), rhs(rhs) {}
+	BinExpr(BinaryOperator const op, Expr::Ref lhs, Expr::Ref rhs) : op(op), lhs(lhs), rhs(rhs)
+	{
+		hashIn(static_cast<int>(op));
+		hashIn(lhs);
+		hashIn(rhs);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override;
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(BinExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class CondExpr : public Expr {
@@ -213,12 +245,19 @@ class CondExpr : public Expr {
 	Expr::Ref then;
 	Expr::Ref else_;
 public:
-	CondExpr(Expr::Ref cond, Expr::Ref then, Expr::Ref else_) : cond(cond), then(then), else_(else_) {}
+	CondExpr(Expr::Ref cond, Expr::Ref then, Expr::Ref else_) : cond(cond), then(then), else_(else_)
+	{
+		hashIn(static_cast<int>(Kind::COND));
+		hashIn(cond);
+		hashIn(then);
+		hashIn(else_);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::COND; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(CondExpr const& e) const;
+	bool equals(Expr const& e) const override;
 
 	Expr::Ref getCond() const { return cond; }
 	Expr::Ref getThen() const { return then; }
@@ -229,49 +268,62 @@ class FunExpr : public Expr {
 	std::string fun;
 	std::vector<Ref> args;
 public:
-	FunExpr(std::string f, std::vector<Ref> const& args) : fun(f), args(args) {}
+	FunExpr(std::string f, std::vector<Ref> const& args) : fun(f), args(args)
+	{
+		hashIn(fun);
+		hashIn(args);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::FN; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(FunExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class BoolLit : public Expr {
 	bool val;
 public:
-	BoolLit(bool b) : val(b) {}
+	BoolLit(bool b) : val(b) { hashIn(val); }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::LIT_BOOL; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(BoolLit const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class IntLit : public Expr {
 	bigint val;
 public:
-	IntLit(std::string i) : val(i) {}
-	IntLit(unsigned long i) : val(i) {}
-	IntLit(long i) : val(i) {}
-	IntLit(bigint i) : val(i) {}
+	IntLit(std::string i) : val(i) { hashIn(val.str()); }
+	IntLit(unsigned long i) : val(i) { hashIn(val.str()); }
+	IntLit(long i) : val(i) { hashIn(val.str()); }
+	IntLit(bigint i) : val(i) { hashIn(val.str()); }
 	bigint getVal() const { return val; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::LIT_INT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(IntLit const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class BvLit : public Expr {
 	std::string val;
 	unsigned width;
 public:
-	BvLit(std::string value, unsigned width) : val(value), width(width) {}
+	BvLit(std::string value, unsigned width) : val(value), width(width)
+	{
+		hashIn(val);
+		hashIn(width);
+	}
 	BvLit(bigint value, unsigned width) : width(width) {
 		std::stringstream s;
 		s << value;
 		val = s.str();
+		hashIn(val);
+		hashIn(width);
 	}
 	std::string getVal() const { return val; }
 	void printBg(std::ostream& os) const override;
@@ -280,39 +332,52 @@ public:
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(BvLit const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class StringLit : public Expr {
 	std::string val;
 public:
-	StringLit(std::string str) : val(str) {}
+	StringLit(std::string str) : val(str) { hashIn(val); }
+	std::string const& getVal() const { return val; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::LIT_STRING; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(StringLit const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class NegExpr : public Expr {
 	Expr::Ref expr;
 public:
-	NegExpr(Expr::Ref expr) : expr(expr) {}
+	NegExpr(Expr::Ref expr) : expr(expr)
+	{
+		hashIn(static_cast<int>(Kind::NEG));
+		hashIn(expr);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::NEG; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(NegExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class NotExpr : public Expr {
 	Expr::Ref expr;
 public:
-	NotExpr(Expr::Ref expr) : expr(expr) {}
+	NotExpr(Expr::Ref expr) : expr(expr)
+	{
+		hashIn(static_cast<int>(Kind::NOT));
+		hashIn(expr);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::NOT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(NotExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class QuantExpr : public Expr {
@@ -323,12 +388,22 @@ private:
 	std::vector<Binding> vars;
 	Ref expr;
 public:
-	QuantExpr(Quantifier q, std::vector<Binding> const& vars, Ref expr) : quant(q), vars(vars), expr(expr) {}
+	QuantExpr(Quantifier q, std::vector<Binding> const& vars, Ref expr) : quant(q), vars(vars), expr(expr)
+	{
+		hashIn(static_cast<int>(quant));
+		for (auto const& b: vars)
+		{
+			hashIn(b.id);
+			hashIn(b.type);
+		}
+		hashIn(expr);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override;
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(QuantExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class SelExpr : public Expr {
@@ -354,24 +429,35 @@ class ArrConstExpr : public Expr {
 	TypeDeclRef arrType;
 	Ref val;
 public:
-	ArrConstExpr(TypeDeclRef arrType, Ref val) : arrType(arrType), val(val) {}
+	ArrConstExpr(TypeDeclRef arrType, Ref val) : arrType(arrType), val(val)
+	{
+		hashIn(arrType);
+		hashIn(val);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::ARRAY_CONST; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(ArrConstExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class ArrSelExpr : public SelExpr {
 	Ref idx;
 public:
-	ArrSelExpr(Ref base, Ref idx) : SelExpr(base), idx(idx) {}
+	ArrSelExpr(Ref base, Ref idx) : SelExpr(base), idx(idx)
+	{
+		hashIn(static_cast<int>(Kind::ARRAY_SELECT));
+		hashIn(base);
+		hashIn(idx);
+	}
 	Ref const& getIdx() const { return idx; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::ARRAY_SELECT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(ArrSelExpr const& e) const;
+	bool equals(Expr const& e) const override;
 	Ref toUpdate(Ref value) const override { return Expr::arrupd(base, idx, value); }
 	Ref replaceBase(Ref newBase) const override { return Expr::arrsel(newBase, idx); }
 };
@@ -380,12 +466,19 @@ class ArrUpdExpr : public UpdExpr {
 	Ref idx;
 public:
 	ArrUpdExpr(Ref base, Ref idx, Ref val)
-		: UpdExpr(base, val), idx(idx) {}
+		: UpdExpr(base, val), idx(idx)
+	{
+		hashIn(static_cast<int>(Kind::ARRAY_UPDATE));
+		hashIn(base);
+		hashIn(idx);
+		hashIn(val);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::ARRAY_UPDATE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(ArrUpdExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class DtSelExpr : public SelExpr {
@@ -394,7 +487,12 @@ class DtSelExpr : public SelExpr {
 	DataTypeDeclRef dt;
 public:
 	DtSelExpr(Ref base, std::string member, FuncDeclRef constr, DataTypeDeclRef dt)
-		: SelExpr(base), member(member), constr(constr), dt(dt) {}
+		: SelExpr(base), member(member), constr(constr), dt(dt)
+	{
+		hashIn(base);
+		hashIn(member);
+		hashIn(constr);
+	}
 	std::string getMember() const { return member; }
 	FuncDeclRef getConstr() const { return constr; }
 	DataTypeDeclRef getDataType() const { return dt; }
@@ -403,6 +501,7 @@ public:
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(DtSelExpr const& e) const;
+	bool equals(Expr const& e) const override;
 	Ref toUpdate(Ref v) const override { return Expr::dtupd(base, member, v, constr, dt); }
 	Ref replaceBase(Ref b) const override { return Expr::dtsel(b, member, constr, dt); }
 };
@@ -413,7 +512,13 @@ class DtUpdExpr : public UpdExpr {
 	DataTypeDeclRef dt;
 public:
 	DtUpdExpr(Ref base, std::string member, Ref v, FuncDeclRef constr, DataTypeDeclRef dt)
-		: UpdExpr(base, v), member(member), constr(constr), dt(dt) {}
+		: UpdExpr(base, v), member(member), constr(constr), dt(dt)
+	{
+		hashIn(base);
+		hashIn(member);
+		hashIn(val);
+		hashIn(constr);
+	}
 	Ref getBase() const { return base; }
 	std::string getMember() const { return member; }
 	FuncDeclRef getConstr() const { return constr; }
@@ -423,41 +528,49 @@ public:
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(DtUpdExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class VarExpr : public Expr {
 	std::string name;
 public:
-	VarExpr(std::string name) : name(name) {}
+	VarExpr(std::string name) : name(name) { hashIn(name); }
 	std::string getName() const { return name; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::VARIABLE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(VarExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class OldExpr : public Expr {
 	Ref expr;
 public:
-	OldExpr(Ref expr) : expr(expr) {}
+	OldExpr(Ref expr) : expr(expr)
+	{
+		hashIn(static_cast<int>(Kind::OLD));
+		hashIn(expr);
+	}
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::OLD; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(OldExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 class TupleExpr : public Expr {
 	std::vector<Ref> elems;
 public:
-	TupleExpr(std::vector<Ref> const& elements): elems(elements) {}
+	TupleExpr(std::vector<Ref> const& elements): elems(elements) { hashIn(elems); }
 	std::vector<Ref> const& elements() const { return elems; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::TUPLE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
 	int cmp(TupleExpr const& e) const;
+	bool equals(Expr const& e) const override;
 };
 
 std::ostream& operator<<(std::ostream& os, Expr const& e);
@@ -17,6 +17,14 @@ namespace bg = boogie;
 namespace solidity::frontend
 {
 
+namespace
+{
+/// Protects the scopes (and the global context) shared by contexts translating in parallel
+mutex scopesMutex;
+/// The balance warning is only reported once, also when merging parallel translations
+ErrorId const balanceWarningId = 5042_error;
+}
+
 /// Magic variables get negative ids for easy differentiation
 int BoogieContext::BoogieGlobalContext::newMagicVariableID()
 {
@@ -88,11 +96,30 @@ BoogieContext::BoogieContext(Encoding encoding,
 		ASTBoogieStats const& stats)
 :
 		m_stats(stats), m_program(), m_encoding(encoding), m_overflow(overflow),
-		m_modAnalysis(modAnalysis), m_errorReporter(errorReporter),
-		m_currentScanner(nullptr), m_scopes(scopes), m_evmVersion(evmVersion),
+		m_modAnalysis(modAnalysis), m_errorReporter(errorReporter), m_topLevelErrorReporter(errorReporter),
+		m_currentScanner(nullptr), m_errorOut(&cerr), m_globalContext(make_shared<BoogieGlobalContext>()),
+		m_scopes(scopes), m_evmVersion(evmVersion),
 		m_currentContractInvars(), m_currentSumSpecs(), m_builtinFunctions(),
 		m_transferIncluded(false), m_callIncluded(false), m_sendIncluded(false),
 		m_warnForBalances(false)
+{
+	addGlobalDeclarations();
+}
+
+BoogieContext::BoogieContext(BoogieContext const& _other, ErrorReporter* errorReporter)
+:
+		m_stats(_other.m_stats), m_program(), m_encoding(_other.m_encoding), m_overflow(_other.m_overflow),
+		m_modAnalysis(_other.m_modAnalysis), m_errorReporter(errorReporter), m_topLevelErrorReporter(errorReporter),
+		m_currentScanner(nullptr), m_errorOut(_other.m_errorOut), m_globalContext(_other.m_globalContext),
+		m_scopes(_other.m_scopes), m_evmVersion(_other.m_evmVersion),
+		m_currentContractInvars(), m_currentSumSpecs(), m_builtinFunctions(),
+		m_transferIncluded(false), m_callIncluded(false), m_sendIncluded(false),
+		m_warnForBalances(false), m_deferErrors(true)
+{
+	addGlobalDeclarations();
+}
+
+void BoogieContext::addGlobalDeclarations()
 {
 	// Initialize global declarations
 	addGlobalComment("Global declarations and definitions");
@@ -114,6 +141,8 @@ BoogieContext::BoogieContext(Encoding encoding,
 	// Allocation counter
 	m_boogieAllocCounter = bg::Decl::variable(ASTBoogieUtils::BOOGIE_ALLOC_COUNTER, bg::Decl::elementarytype("int"));
 	addDecl(m_boogieAllocCounter);
+
+	m_prologueSize = m_program.getDeclarations().size();
 }
 
 bg::VarDeclRef BoogieContext::freshTempVar(bg::TypeDeclRef type, string prefix)
@@ -123,6 +152,14 @@ bg::VarDeclRef BoogieContext::freshTempVar(bg::TypeDeclRef type, string prefix)
 
 void BoogieContext::printErrors(ostream& out)
 {
+	// When translating in parallel, errors are printed when merged to keep their order
+	if (m_deferErrors)
+	{
+		for (auto const& error: errorReporter()->errors())
+			m_deferredErrors.push_back(error);
+		return;
+	}
+
 	SourceReferenceFormatter formatter(out);
 	for (auto const& error: errorReporter()->errors())
 		formatter.printExceptionInformation(*error,
@@ -315,9 +352,9 @@ list<bg::Stmt::Ref> BoogieContext::updateSumVars(bg::Expr::Ref lhsBg, bg::Expr::
 list<bg::Stmt::Ref> BoogieContext::havocSumVars()
 {
 	list<bg::Stmt::Ref> havocs;
-	for (auto entry: m_currentSumSpecs)
-		for (auto spec: entry.second)
-				havocs.push_back(bg::Stmt::havoc(spec.shadowVar->getName()));
+	for (auto contr: m_currentContract->annotation().linearizedBaseContracts)
+		for (auto spec: m_currentSumSpecs[contr])
+			havocs.push_back(bg::Stmt::havoc(spec.shadowVar->getName()));
 	return havocs;
 }
 
@@ -376,9 +413,10 @@ string BoogieContext::mapDeclName(Declaration const& decl)
 
 void BoogieContext::warnForBalances()
 {
+	// Reported at the top level, independently of where it is first encountered
 	if (!m_warnForBalances)
 	{
-		m_errorReporter->warning(5042_error, "Balance modifications due to gas consumption or miner rewards are not modeled");
+		m_topLevelErrorReporter->warning(balanceWarningId, "Balance modifications due to gas consumption or miner rewards are not modeled");
 	}
 	m_warnForBalances = true;
 }
@@ -1471,20 +1509,96 @@ std::pair<boogie::Expr::Ref, std::string> BoogieContext::getEventLoopInvariant(E
 
 void BoogieContext::setCurrentContract(ContractDefinition const* contract)
 {
-	if (contract)
+	lock_guard<mutex> lock(scopesMutex);
+	m_currentContract = contract;
+	registerThisAndSuper();
+}
+
+void BoogieContext::registerThisAndSuper()
+{
+	if (m_currentContract)
 	{
-		m_globalContext.setCurrentContract(*contract);
-		m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentSuper(), false, true);
-		m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentThis(), false, true);
+		m_globalContext->setCurrentContract(*m_currentContract);
+		m_scopes[nullptr]->registerDeclaration(*m_globalContext->currentSuper(), false, true);
+		m_scopes[nullptr]->registerDeclaration(*m_globalContext->currentThis(), false, true);
 	}
 	else
 	{
 		// make "this" and "super" invisible.
-		m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentThis(), true, true);
-		m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentSuper(), true, true);
-		m_globalContext.resetCurrentContract();
+		m_scopes[nullptr]->registerDeclaration(*m_globalContext->currentThis(), true, true);
+		m_scopes[nullptr]->registerDeclaration(*m_globalContext->currentSuper(), true, true);
+		m_globalContext->resetCurrentContract();
 	}
-	m_currentContract = contract;
+}
+
+unique_lock<mutex> BoogieContext::lockScopes()
+{
+	unique_lock<mutex> lock(scopesMutex);
+	// Another context might have changed the current contract in the meantime
+	registerThisAndSuper();
+	return lock;
+}
+
+void BoogieContext::importSpecs(BoogieContext const& _other)
+{
+	// Sum specifications of a contract are only appended to (by the context translating
+	// the contract), so the longest list is the most recent
+	for (auto const& entry: _other.m_currentSumSpecs)
+		if (entry.second.size() > m_currentSumSpecs[entry.first].size())
+			m_currentSumSpecs[entry.first] = entry.second;
+
+	for (auto const& entry: _other.m_eventData)
+		m_eventData[entry.first].insert(entry.second.begin(), entry.second.end());
+	for (auto const& entry: _other.m_allEventData)
+	{
+		auto it = m_allEventData.find(entry.first);
+		if (it == m_allEventData.end())
+			m_allEventData[entry.first] = entry.second;
+		else
+			it->second.events.insert(entry.second.events.begin(), entry.second.events.end());
+	}
+	m_eventDataSubstitution.insert(_other.m_eventDataSubstitution.begin(), _other.m_eventDataSubstitution.end());
+}
+
+void BoogieContext::merge(BoogieContext& _other)
+{
+	// The balance warning might have been reported by this context already
+	bool warnedForBalances = m_warnForBalances;
+	m_warnForBalances = m_warnForBalances || _other.m_warnForBalances;
+	auto isDuplicate = [warnedForBalances](shared_ptr<Error const> const& _error) {
+		return warnedForBalances && _error->errorId() == balanceWarningId;
+	};
+
+	// Errors printed during the translation
+	SourceReferenceFormatter formatter(*m_errorOut);
+	for (auto const& error: _other.m_deferredErrors)
+		if (!isDuplicate(error))
+			formatter.printExceptionInformation(*error,
+					(error->type() == Error::Type::Warning) ? "solc-verify warning" : "solc-verify error");
+	_other.m_deferredErrors.clear();
+
+	// Errors to be reported at the end
+	ErrorList errors;
+	for (auto const& error: _other.errorReporter()->errors())
+		if (!isDuplicate(error))
+			errors.push_back(error);
+	m_errorReporter->append(errors);
+
+	// Declarations
+	auto& decls = m_program.getDeclarations();
+	for (; m_declNamesUpTo < decls.size(); ++m_declNamesUpTo)
+		if (decls[m_declNamesUpTo]->getKind() != bg::Decl::COMMENT)
+			m_declNames.insert(decls[m_declNamesUpTo]->getName());
+
+	auto const& otherDecls = _other.m_program.getDeclarations();
+	for (size_t i = _other.m_prologueSize; i < otherDecls.size(); ++i)
+	{
+		auto decl = otherDecls[i];
+		if (decl->getKind() != bg::Decl::COMMENT && !decl->getName().empty() && !m_declNames.insert(decl->getName()).second)
+			continue;
+		decls.push_back(decl);
+	}
+	m_declNamesUpTo = decls.size();
 }
 
 
@@ -11,6 +11,7 @@
 #include <libsolidity/boogie/BoogieAstDecl.h>
 #include <libsolidity/boogie/BoogieAstExpr.h>
 #include <libsolidity/boogie/BoogieAstStmt.h>
+#include <mutex>
 #include <set>
 
 namespace solidity::frontend
@@ -159,10 +160,12 @@ private:
 	bool m_overflow;
 	bool m_modAnalysis;
 	langutil::ErrorReporter* m_errorReporter; // Report errors with this member
+	langutil::ErrorReporter* m_topLevelErrorReporter; // Reporter given at construction (not replaced by temporary ones)
 	langutil::Scanner const* m_currentScanner; // Scanner used to resolve locations in the original source
+	std::ostream* m_errorOut; // Errors found during the translation are printed here
 
 	// Some members required to parse expressions from comments
-	BoogieGlobalContext m_globalContext;
+	std::shared_ptr<BoogieGlobalContext> m_globalContext; // Shared by contexts translating in parallel
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	langutil::EVMVersion m_evmVersion;
 
@@ -188,6 +191,21 @@ private:
 
 	bool m_warnForBalances;
 
+	// Number of global declarations added by the constructor (skipped when merging)
+	size_t m_prologueSize = 0;
+	// Errors printed when merged into the main context (for parallel translation)
+	bool m_deferErrors = false;
+	std::vector<std::shared_ptr<langutil::Error const>> m_deferredErrors;
+	// Names of the declarations in the program, used to skip duplicates when merging
+	std::set<std::string> m_declNames;
+	size_t m_declNamesUpTo = 0;
+
+	/** Adds the global declarations (address type, balance, etc.) to the program. */
+	void addGlobalDeclarations();
+
+	/** Makes 'this' and 'super' of the current contract (if any) visible in the global scope. */
+	void registerThisAndSuper();
+
 public:
 
 	BoogieContext(Encoding encoding,
@@ -198,6 +216,14 @@ public:
 			langutil::EVMVersion evmVersion,
 			ASTBoogieStats const& stats);
 
+	/**
+	 * Creates a context for translating a part of the program in parallel with other
+	 * contexts. The new context shares the configuration, the scopes and the global
+	 * context with _other, but it has its own program, error reporter and caches.
+	 * The result can be merged into the main context with 'merge'.
+	 */
+	BoogieContext(BoogieContext const& _other, langutil::ErrorReporter* errorReporter);
+
 	ASTBoogieStats const& stats() const { return m_stats; }
 	Encoding encoding() const { return m_encoding; }
 	bool isBvEncoding() const { return m_encoding == Encoding::BV; }
@@ -205,20 +231,46 @@ public:
 	bool modAnalysis() const { return m_modAnalysis; }
 	langutil::ErrorReporter*& errorReporter() { return m_errorReporter; }
 	langutil::Scanner const*& currentScanner() { return m_currentScanner; }
-	GlobalContext* globalContext() { return &m_globalContext; }
+	GlobalContext* globalContext() { return m_globalContext.get(); }
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& scopes() { return m_scopes; }
 	langutil::EVMVersion& evmVersion() { return m_evmVersion; }
 	std::list<DocTagExpr>& currentContractInvars() { return m_currentContractInvars; }
 	int nextId() { return m_nextId++; }
+	void resetNextId() { m_nextId = 0; }
 	boogie::VarDeclRef freshTempVar(boogie::TypeDeclRef type, std::string prefix = "tmp");
 	ContractDefinition const* currentContract() const { return m_currentContract; }
 	void setCurrentContract(ContractDefinition const* contract);
 	SourceUnit const* currentSource() const { return m_currentSource; }
 	void setCurrentSource(SourceUnit const* source) { m_currentSource = source; }
 	void printErrors(std::ostream& out);
+	/** Prints the errors to the error output of the context (standard error by default). */
+	void printErrors() { printErrors(*m_errorOut); }
+	void setErrorOut(std::ostream& out) { m_errorOut = &out; }
+
+	/**
+	 * Locks the scopes shared by contexts translating in parallel and makes 'this'
+	 * and 'super' of the current contract visible. Annotations must be resolved
+	 * while holding the lock.
+	 */
+	std::unique_lock<std::mutex> lockScopes();
+
+	/**
+	 * Imports the sum and event specifications collected by another context, so that
+	 * contracts sharing a base with the contracts translated there can use them.
+	 */
+	void importSpecs(BoogieContext const& _other);
+
+	/**
+	 * Merges the result of another context (created for parallel translation) into this
+	 * one: prints its errors and appends its declarations (except for the global ones).
+	 * Declarations created on demand (e.g., struct types, array datatypes) are skipped
+	 * if already present, keeping the first one as in a serial translation.
+	 */
+	void merge(BoogieContext& _other);
 
 	/** Prints the Boogie program to an output stream. */
 	void print(std::ostream& _stream) { m_program.print(_stream); }
+	boogie::Program& program() { return m_program; }
 
 	// Built-in functions and members
 	void includeTransferFunction();
@@ -0,0 +1,172 @@
+#include <libsolidity/boogie/BoogieSlicer.h>
+
+#include <libsolidity/boogie/BoogieAstExpr.h>
+
+#include <sstream>
+
+using namespace std;
+
+namespace boogie
+{
+
+namespace
+{
+
+bool isIdentifierChar(char c)
+{
+	return isalnum(static_cast<unsigned char>(c)) || string("_.$#'`~^\\?@").find(c) != string::npos;
+}
+
+/** Collects the identifiers of a printed declaration, skipping string literals (attributes). */
+set<string> collectIdentifiers(string const& text)
+{
+	set<string> identifiers;
+	for (size_t i = 0; i < text.size();)
+	{
+		if (text[i] == '"')
+		{
+			size_t end = text.find('"', i + 1);
+			i = end == string::npos ? text.size() : end + 1;
+		}
+		else if (isIdentifierChar(text[i]))
+		{
+			size_t end = i;
+			while (end < text.size() && isIdentifierChar(text[end]))
+				end++;
+			if (!isdigit(static_cast<unsigned char>(text[i])))
+				identifiers.insert(text.substr(i, end - i));
+			i = end;
+		}
+		else
+			i++;
+	}
+	return identifiers;
+}
+
+set<string> collectIdentifiers(Decl const& decl)
+{
+	stringstream text;
+	decl.print(text);
+	return collectIdentifiers(text.str());
+}
+
+}
+
+ProgramSlicer::ProgramSlicer(Program const& program)
+{
+	for (auto const& decl: program.getDeclarations())
+	{
+		if (decl->getKind() == Decl::COMMENT)
+			continue;
+		size_t index = m_decls.size();
+		m_decls.push_back(decl);
+		m_references.push_back(collectIdentifiers(*decl));
+
+		if (decl->getKind() == Decl::AXIOM || decl->getKind() == Decl::CODE)
+			m_axioms.push_back(index);
+		else
+			m_declsByName.emplace(decl->getName(), index);
+
+		// Datatypes need their constructors, even if they are not referenced
+		if (auto func = dynamic_pointer_cast<FuncDecl const>(decl))
+			for (auto const& attr: func->getAttrs())
+				if (attr->getName() == "constructor")
+					m_constructors.emplace(func->getType()->getName(), index);
+	}
+}
+
+Program ProgramSlicer::slice(string const& procedure) const
+{
+	Closure closure;
+	closure.included.resize(m_decls.size(), false);
+	for (auto [it, end] = m_declsByName.equal_range(procedure); it != end; ++it)
+		if (m_decls[it->second]->getKind() == Decl::PROCEDURE)
+			include(it->second, closure);
+	if (closure.worklist.empty())
+		return Program();
+
+	// Axioms can constrain anything they mention, so they are added until a fixed point
+	bool changed = true;
+	while (changed)
+	{
+		while (!closure.worklist.empty())
+		{
+			size_t index = closure.worklist.back();
+			closure.worklist.pop_back();
+			includeReferences(index, closure);
+		}
+		changed = false;
+		for (size_t axiom: m_axioms)
+			if (!closure.included[axiom] && isRelevant(axiom, closure))
+			{
+				include(axiom, closure);
+				changed = true;
+			}
+	}
+
+	Program result;
+	for (size_t i = 0; i < m_decls.size(); ++i)
+		if (closure.included[i])
+			result.getDeclarations().push_back(m_decls[i]);
+	return result;
+}
+
+vector<ProcDeclRef> ProgramSlicer::verifiedProcedures() const
+{
+	vector<ProcDeclRef> procedures;
+	for (auto const& decl: m_decls)
+		if (auto proc = dynamic_pointer_cast<ProcDecl>(decl))
+			if (!proc->getAttrs().empty())
+				procedures.push_back(proc);
+	return procedures;
+}
+
+void ProgramSlicer::include(string const& name, Closure& closure) const
+{
+	for (auto [it, end] = m_declsByName.equal_range(name); it != end; ++it)
+		include(it->second, closure);
+}
+
+void ProgramSlicer::include(size_t index, Closure& closure) const
+{
+	if (closure.included[index])
+		return;
+	closure.included[index] = true;
+	closure.names.insert(m_decls[index]->getName());
+	closure.worklist.push_back(index);
+}
+
+void ProgramSlicer::includeReferences(size_t index, Closure& closure) const
+{
+	for (auto const& name: m_references[index])
+	{
+		include(name, closure);
+		// Datatype selectors are printed as member#constructor, where both parts
+		// can contain '#' as well, so all splits are considered (over-approximation)
+		for (size_t pos = name.find('#'); pos != string::npos; pos = name.find('#', pos + 1))
+		{
+			include(name.substr(0, pos), closure);
+			include(name.substr(pos + 1), closure);
+		}
+	}
+	if (m_decls[index]->getKind() == Decl::TYPE)
+		for (auto [it, end] = m_constructors.equal_range(m_decls[index]->getName()); it != end; ++it)
+			include(it->second, closure);
+}
+
+bool ProgramSlicer::isRelevant(size_t axiom, Closure const& closure) const
+{
+	// Axioms without references (e.g., raw code) are always kept
+	bool declaresNothing = true;
+	for (auto const& name: m_references[axiom])
+	{
+		if (!m_declsByName.count(name))
+			continue;
+		declaresNothing = false;
+		if (closure.names.count(name))
+			return true;
+	}
+	return declaresNothing;
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace boogie
+{
+
+/**
+ * Computes the part of a program that a procedure depends on, so that the procedure
+ * can be verified without loading the rest of the program. The slice of a procedure
+ * contains the transitive closure of the declarations (types, constructors, constants,
+ * variables, functions and procedures) referenced from it, together with the axioms
+ * that mention any of them, in their original order. Called procedures are included
+ * with their bodies, so that the modifies sets inferred by Boogie are the same as for
+ * the whole program.
+ * References are collected from the printed declarations once, when the slicer is
+ * created, so slicing many procedures of the same program is cheap.
+ */
+class ProgramSlicer
+{
+public:
+	explicit ProgramSlicer(Program const& program);
+
+	/** @returns the slice of a procedure of the program (empty if there is no such procedure) */
+	Program slice(std::string const& procedure) const;
+
+	/** @returns the procedures that are verified (i.e., that have attributes) */
+	std::vector<ProcDeclRef> verifiedProcedures() const;
+
+private:
+	/** Declarations included in a slice so far. */
+	struct Closure
+	{
+		std::vector<bool> included;
+		std::set<std::string> names;
+		std::vector<size_t> worklist;
+	};
+
+	/** Includes the declarations with a given name (if not already included). */
+	void include(std::string const& name, Closure& closure) const;
+	void include(size_t index, Closure& closure) const;
+	/** Includes the declarations referenced by a declaration that is already included. */
+	void includeReferences(size_t index, Closure& closure) const;
+	/** @returns true if an axiom should be included, i.e., it mentions an included declaration */
+	bool isRelevant(size_t axiom, Closure const& closure) const;
+
+	std::vector<DeclRef> m_decls;
+	std::vector<std::set<std::string>> m_references; // Names referenced by each declaration
+	std::multimap<std::string, size_t> m_declsByName;
+	std::multimap<std::string, size_t> m_constructors; // Datatype name to its constructors
+	std::vector<size_t> m_axioms; // Unnamed declarations (axioms and raw code)
+};
+
+}
@@ -0,0 +1,60 @@
+#include <libsolidity/boogie/BoogieTranslator.h>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend
+{
+
+BoogieTranslator::BoogieTranslator(
+	CompilerStack const& compiler,
+	vector<string> sourceNames,
+	Settings const& settings,
+	ErrorReporter& errorReporter
+):
+	m_compiler(compiler),
+	m_sourceNames(move(sourceNames)),
+	m_settings(settings)
+{
+	for (auto const& sourceName: m_sourceNames)
+		m_compiler.ast(sourceName).accept(m_stats);
+
+	m_context = make_unique<BoogieContext>(m_settings.encoding, m_settings.overflow,
+			m_settings.modAnalysis || m_stats.hasModifiesSpecs(),
+			&errorReporter, m_compiler.getScopes(), m_settings.evmVersion, m_stats);
+	m_converter = make_unique<ASTBoogieConverter>(*m_context);
+}
+
+bool BoogieTranslator::prepare()
+{
+	EmitsChecker emitsChecker(*m_context);
+	for (auto const& sourceName: m_sourceNames)
+	{
+		m_context->currentScanner() = &m_compiler.scanner(sourceName);
+		m_compiler.ast(sourceName).accept(emitsChecker);
+	}
+
+	if (m_settings.eventAnalysis || m_stats.hasEventSpecs())
+		if (!emitsChecker.check())
+			return false;
+
+	if (m_settings.jobs > 1)
+	{
+		m_parallelConverter = make_unique<ParallelBoogieConverter>(*m_context, m_settings.jobs);
+		for (auto const& sourceName: m_sourceNames)
+			m_parallelConverter->addSource(m_compiler.ast(sourceName), m_compiler.scanner(sourceName));
+		m_parallelConverter->start();
+	}
+	return true;
+}
+
+void BoogieTranslator::translate(string const& sourceName)
+{
+	m_context->currentScanner() = &m_compiler.scanner(sourceName);
+	if (m_parallelConverter)
+		m_parallelConverter->merge(m_compiler.ast(sourceName));
+	else
+		m_converter->convert(m_compiler.ast(sourceName));
+}
+
+}
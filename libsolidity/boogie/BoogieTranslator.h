@@ -0,0 +1,76 @@
+#pragma once
+
+#include <libsolidity/boogie/ASTBoogieConverter.h>
+#include <libsolidity/boogie/ASTBoogieStats.h>
+#include <libsolidity/boogie/BoogieContext.h>
+#include <libsolidity/boogie/EmitsChecker.h>
+#include <libsolidity/boogie/ParallelBoogieConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Translates the analyzed sources of a compiler stack to a single Boogie program.
+ * Used by both solc (--boogie) and the solc-verify driver.
+ */
+class BoogieTranslator
+{
+public:
+	struct Settings
+	{
+		BoogieContext::Encoding encoding = BoogieContext::Encoding::INT;
+		bool overflow = false;
+		bool modAnalysis = false; // Enable modifies analysis even without specs
+		bool eventAnalysis = false; // Enable event analysis even without specs
+		unsigned jobs = 1; // Number of threads used for the translation
+		langutil::EVMVersion evmVersion;
+	};
+
+	/**
+	 * Create a new translator.
+	 * @param compiler Compiler stack with the analyzed sources
+	 * @param sourceNames Sources to translate (in this order)
+	 * @param settings Settings of the translation
+	 * @param errorReporter Reporter for the errors of the translation
+	 */
+	BoogieTranslator(
+		CompilerStack const& compiler,
+		std::vector<std::string> sourceNames,
+		Settings const& settings,
+		langutil::ErrorReporter& errorReporter
+	);
+
+	/**
+	 * Checks the 'emits' specifications (if needed) and starts the parallel translation
+	 * (if enabled). Must be called before translating the sources.
+	 * @returns False if the specifications are not satisfied (errors are reported)
+	 */
+	bool prepare();
+
+	/**
+	 * Translates a source, sources must be translated in the order they were given.
+	 * Compiler errors thrown during the translation are passed on.
+	 */
+	void translate(std::string const& sourceName);
+
+	BoogieContext& context() { return *m_context; }
+
+private:
+	CompilerStack const& m_compiler;
+	std::vector<std::string> m_sourceNames;
+	Settings m_settings;
+
+	ASTBoogieStats m_stats;
+	std::unique_ptr<BoogieContext> m_context;
+	std::unique_ptr<ASTBoogieConverter> m_converter;
+	std::unique_ptr<ParallelBoogieConverter> m_parallelConverter;
+};
+
+}
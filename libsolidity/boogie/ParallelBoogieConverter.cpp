@@ -0,0 +1,154 @@
+#include <libsolidity/boogie/ParallelBoogieConverter.h>
+#include <libsolidity/boogie/ASTBoogieConverter.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::frontend
+{
+
+ParallelBoogieConverter::ParallelBoogieConverter(BoogieContext& context, unsigned jobs)
+:
+		m_context(context), m_jobs(max(jobs, 1u))
+{
+}
+
+ParallelBoogieConverter::~ParallelBoogieConverter()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_cancelled = true;
+	}
+	m_changed.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+void ParallelBoogieConverter::addSource(SourceUnit const& _source, Scanner const& _scanner)
+{
+	solAssert(m_workers.empty(), "Sources must be added before starting the translation");
+
+	for (auto const& node: _source.nodes())
+	{
+		auto job = make_unique<Job>();
+		job->source = &_source;
+		job->scanner = &_scanner;
+		job->node = node.get();
+
+		// Contracts depend on earlier contracts that they share a base with (including
+		// their own bases): the serial translation would have collected the sum and event
+		// specifications of those contracts by the time this one is reached
+		if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+		{
+			auto const& bases = contract->annotation().linearizedBaseContracts;
+			for (size_t i = 0; i < m_jobList.size(); ++i)
+			{
+				auto other = dynamic_cast<ContractDefinition const*>(m_jobList[i]->node);
+				if (!other)
+					continue;
+				for (auto otherBase: other->annotation().linearizedBaseContracts)
+				{
+					if (find(bases.begin(), bases.end(), otherBase) != bases.end())
+					{
+						job->dependencies.push_back(i);
+						break;
+					}
+				}
+			}
+		}
+		m_jobList.push_back(move(job));
+	}
+}
+
+void ParallelBoogieConverter::start()
+{
+	size_t workers = min<size_t>(m_jobs, m_jobList.size());
+	for (size_t i = 0; i < workers; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+void ParallelBoogieConverter::merge(SourceUnit const& _source)
+{
+	ASTBoogieConverter(m_context).beginSourceUnit(_source);
+
+	for (; m_nextToMerge < m_jobList.size() && m_jobList[m_nextToMerge]->source == &_source; ++m_nextToMerge)
+	{
+		Job& job = *m_jobList[m_nextToMerge];
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_changed.wait(lock, [&job]() { return job.done; });
+			if (job.exception)
+				m_cancelled = true;
+		}
+		// Merge even if there was an exception to get the errors reported up to that point
+		if (job.context)
+			m_context.merge(*job.context);
+		if (job.exception)
+			rethrow_exception(job.exception);
+	}
+}
+
+void ParallelBoogieConverter::work()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		Job* job = nextJob();
+		if (!job)
+		{
+			bool allStarted = all_of(m_jobList.begin(), m_jobList.end(), [](auto const& j) { return j->started; });
+			if (m_cancelled || allStarted)
+				return;
+			m_changed.wait(lock);
+			continue;
+		}
+
+		job->started = true;
+		lock.unlock();
+		translate(*job);
+		lock.lock();
+		job->done = true;
+		m_changed.notify_all();
+	}
+}
+
+ParallelBoogieConverter::Job* ParallelBoogieConverter::nextJob()
+{
+	if (m_cancelled)
+		return nullptr;
+	// Prefer earlier jobs, they are merged first
+	for (auto& job: m_jobList)
+	{
+		if (job->started)
+			continue;
+		bool ready = all_of(job->dependencies.begin(), job->dependencies.end(),
+				[this](size_t i) { return m_jobList[i]->done; });
+		if (ready)
+			return job.get();
+	}
+	return nullptr;
+}
+
+void ParallelBoogieConverter::translate(Job& _job)
+{
+	try
+	{
+		_job.errorReporter = make_unique<ErrorReporter>(_job.errorList);
+		_job.context = make_unique<BoogieContext>(m_context, _job.errorReporter.get());
+		for (size_t i: _job.dependencies)
+			if (m_jobList[i]->context)
+				_job.context->importSpecs(*m_jobList[i]->context);
+
+		_job.context->currentScanner() = _job.scanner;
+		_job.context->setCurrentSource(_job.source);
+		ASTBoogieConverter(*_job.context).convertTopLevelNode(*_job.node);
+	}
+	catch (...)
+	{
+		_job.exception = current_exception();
+	}
+}
+
+}
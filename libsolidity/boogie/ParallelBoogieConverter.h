@@ -0,0 +1,92 @@
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/boogie/BoogieContext.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Converts the top-level nodes (contracts, structs, ...) of source units to Boogie
+ * using multiple threads. Each node is translated into a separate context, which is
+ * then merged into the main context in source order, so that the resulting program
+ * is the same as with the (serial) ASTBoogieConverter.
+ *
+ * A contract is only translated after all earlier contracts sharing a base contract
+ * with it are done, because it may need their sum and event specifications.
+ */
+class ParallelBoogieConverter
+{
+public:
+	/**
+	 * Create a new instance.
+	 * @param context Main context, the result is merged here
+	 * @param jobs Number of worker threads
+	 */
+	ParallelBoogieConverter(BoogieContext& context, unsigned jobs);
+
+	/** Cancels the remaining nodes and waits for the workers. */
+	~ParallelBoogieConverter();
+
+	/**
+	 * Adds all top-level nodes of a source unit for translation.
+	 * Sources must be added before calling 'start'.
+	 */
+	void addSource(SourceUnit const& _source, langutil::Scanner const& _scanner);
+
+	/** Starts the worker threads. */
+	void start();
+
+	/**
+	 * Waits for the nodes of a source unit and merges them into the main context.
+	 * Sources must be merged in the order they were added. Exceptions thrown while
+	 * translating the source are rethrown here.
+	 */
+	void merge(SourceUnit const& _source);
+
+private:
+	/** A top-level node to be translated. */
+	struct Job {
+		SourceUnit const* source;
+		langutil::Scanner const* scanner;
+		ASTNode const* node;
+		std::vector<size_t> dependencies; // Earlier jobs that have to be finished first
+		langutil::ErrorList errorList;
+		std::unique_ptr<langutil::ErrorReporter> errorReporter;
+		std::unique_ptr<BoogieContext> context; // Result of the translation
+		std::exception_ptr exception; // Exception thrown during translation (if any)
+		bool started = false;
+		bool done = false;
+	};
+
+	/** Main loop of the worker threads. */
+	void work();
+
+	/** Translates a single node in its own context. */
+	void translate(Job& _job);
+
+	/** Returns the next job that can be started (or null). Requires m_mutex to be held. */
+	Job* nextJob();
+
+	BoogieContext& m_context;
+	unsigned m_jobs;
+
+	std::vector<std::unique_ptr<Job>> m_jobList;
+	size_t m_nextToMerge = 0;
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_changed; // Signaled when a job is done
+	bool m_cancelled = false;
+};
+
+}
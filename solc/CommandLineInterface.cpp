@@ -29,10 +29,8 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
-#include <libsolidity/boogie/ASTBoogieConverter.h>
-#include <libsolidity/boogie/ASTBoogieStats.h>
-#include <libsolidity/boogie/BoogieContext.h>
-#include <libsolidity/boogie/EmitsChecker.h>
+#include <libsolidity/boogie/BoogieSlicer.h>
+#include <libsolidity/boogie/BoogieTranslator.h>
 #include <libsolidity/analysis/GlobalContext.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
@@ -136,6 +134,8 @@ static string const g_strAstBoogieArithMod = "mod";
 static string const g_strAstBoogieArithModOverflow = "mod-overflow";
 static string const g_strAstBoogieModAnalysis = "boogie-mod-analysis";
 static string const g_strAstBoogieEventAnalysis = "boogie-event-analysis";
+static string const g_strAstBoogieJobs = "boogie-jobs";
+static string const g_strAstBoogieSlice = "boogie-slice";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
@@ -226,6 +226,8 @@ static string const g_argAstBoogie = g_strAstBoogie;
 static string const g_argAstBoogieArith = g_strAstBoogieArith;
 static string const g_argAstBoogieModAnalysis = g_strAstBoogieModAnalysis;
 static string const g_argAstBoogieEventAnalysis = g_strAstBoogieEventAnalysis;
+static string const g_argAstBoogieJobs = g_strAstBoogieJobs;
+static string const g_argAstBoogieSlice = g_strAstBoogieSlice;
 static string const g_argErrorRecovery = g_strErrorRecovery;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
@@ -994,6 +996,16 @@ General Information)").c_str(),
 		)
 		(g_argAstBoogieModAnalysis.c_str(), "Enable modifies analysis in Boogie even if there is no spec.")
 		(g_argAstBoogieEventAnalysis.c_str(), "Enable event analysis in Boogie even if there is no spec.")
+		(
+				g_argAstBoogieJobs.c_str(),
+				po::value<unsigned>()->value_name("n")->default_value(1),
+				"Number of threads used to translate contracts to Boogie. The result does not depend on it."
+		)
+		(
+				g_argAstBoogieSlice.c_str(),
+				"Also output a separate Boogie program for each procedure to be verified, "
+				"containing only the declarations it depends on."
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -1791,32 +1803,27 @@ void CommandLineInterface::handleBoogie()
 	ErrorList errorList;
 	ErrorReporter errorReporter(errorList);
 
-	ASTBoogieStats stats;
-	for (auto const& sourceCode: m_sourceCodes)
-		m_compiler->ast(sourceCode.first).accept(stats);
-
-
-	BoogieContext::Encoding encoding = BoogieContext::Encoding::INT;
-	bool overflow = false;
+	BoogieTranslator::Settings settings;
+	settings.evmVersion = m_evmVersion;
 	if (m_args.count(g_argAstBoogieArith))
 	{
 		string encodingStr = m_args[g_argAstBoogieArith].as<string>();
 		if (encodingStr == g_strAstBoogieArithBv)
 		{
-			encoding = BoogieContext::Encoding::BV;
+			settings.encoding = BoogieContext::Encoding::BV;
 		}
 		else if (encodingStr == g_strAstBoogieArithInt)
 		{
-			encoding = BoogieContext::Encoding::INT;
+			settings.encoding = BoogieContext::Encoding::INT;
 		}
 		else if (encodingStr == g_strAstBoogieArithMod)
 		{
-			encoding = BoogieContext::Encoding::MOD;
+			settings.encoding = BoogieContext::Encoding::MOD;
 		}
 		else if (encodingStr == g_strAstBoogieArithModOverflow)
 		{
-			encoding = BoogieContext::Encoding::MOD;
-			overflow = true;
+			settings.encoding = BoogieContext::Encoding::MOD;
+			settings.overflow = true;
 		}
 		else
 		{
@@ -1825,34 +1832,26 @@ void CommandLineInterface::handleBoogie()
 			return;
 		}
 	}
+	settings.modAnalysis = m_args.count(g_strAstBoogieModAnalysis);
+	settings.eventAnalysis = m_args.count(g_strAstBoogieEventAnalysis);
+	settings.jobs = m_args[g_argAstBoogieJobs].as<unsigned>();
 
-	BoogieContext context(encoding, overflow,
-			m_args.count(g_strAstBoogieModAnalysis) || stats.hasModifiesSpecs(),
-			&errorReporter, m_compiler->getScopes(), m_evmVersion, stats);
-	ASTBoogieConverter boogieConverter(context);
-	EmitsChecker emitsChecker(context);
-
-	SourceReferenceFormatter formatter(serr(false));
-
+	vector<string> sourceNames;
 	for (auto const& sourceCode: m_sourceCodes)
-	{
-		context.currentScanner() = &m_compiler->scanner(sourceCode.first);
-		m_compiler->ast(sourceCode.first).accept(emitsChecker);
-	}
+		sourceNames.push_back(sourceCode.first);
+	BoogieTranslator translator(*m_compiler, sourceNames, settings, errorReporter);
+	BoogieContext& context = translator.context();
 
-	bool eventsOk = true;
-	if (m_args.count(g_strAstBoogieEventAnalysis) || stats.hasEventSpecs())
-		eventsOk = emitsChecker.check();
+	SourceReferenceFormatter formatter(serr(false));
 
-	if (eventsOk)
+	if (translator.prepare())
 	{
 		for (auto const& sourceCode: m_sourceCodes)
 		{
 			sout() << endl << "======= " << sourceCode.first << " =======" << endl;
 			try
 			{
-				context.currentScanner() = &m_compiler->scanner(sourceCode.first);
-				boogieConverter.convert(m_compiler->ast(sourceCode.first));
+				translator.translate(sourceCode.first);
 			}
 			catch (CompilerError const& _exception)
 			{
@@ -1890,6 +1889,27 @@ void CommandLineInterface::handleBoogie()
 	{
 		context.print(sout());
 	}
+
+	if (m_args.count(g_argAstBoogieSlice))
+	{
+		boogie::ProgramSlicer slicer(context.program());
+		for (auto const& procedure: slicer.verifiedProcedures())
+		{
+			boogie::Program slice = slicer.slice(procedure->getName());
+			if (m_args.count(g_argOutputDir))
+			{
+				stringstream data;
+				slice.print(data);
+				boost::filesystem::path path(m_args[g_argInputFile].as<vector<string>>()[0]);
+				createFile(path.filename().string() + "." + procedure->getName() + ".bpl", data.str());
+			}
+			else
+			{
+				sout() << endl << "======= " << procedure->getName() << " =======" << endl;
+				slice.print(sout());
+			}
+		}
+	}
 }
 
 bool CommandLineInterface::actOnInput()
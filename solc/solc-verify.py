@@ -245,9 +245,13 @@ def verifyAll(bplFile, args):
             result = prog.match(line)
             if (result):
                 procedureId = result.group('procedure_name')
+                # Slices are printed by solc next to the program as <name>.<procedure>.bpl
+                procedureFile = bplFile
+                if args.slice:
+                    procedureFile = bplFile[:-len('.bpl')] + '.' + procedureId + '.bpl'
                 for solver in solvers:
                     verifyProcedureArgs.append({
-                        "bplFile": bplFile,
+                        "bplFile": procedureFile,
                         "procedureId": procedureId,
                         "args": args,
                         "solver": solver
@@ -282,10 +286,12 @@ def main(tmpDir):
     parser.add_argument('--modifies-analysis', action='store_true', help='Perform modification analysis on state variables')
     parser.add_argument('--event-analysis', action='store_true', help='Perform analysis on emitted events and data changes')
     parser.add_argument('--parallel', type=int, help='How many cores to use', default=multiprocessing.cpu_count())
+    parser.add_argument('--boogie-jobs', type=int, help='How many threads the compiler uses to translate contracts to Boogie', default=1)
 
     parser.add_argument('--output', type=str, help='Output directory for the Boogie program')
     parser.add_argument('--verbose', action='store_true', help='Print all output of the compiler and the verifier')
     parser.add_argument('--smt-log', type=str, help='Log input for the SMT solver')
+    parser.add_argument('--slice', action='store_true', help='Verify each function in a separate Boogie program containing only the declarations it depends on')
     parser.add_argument('--errors-only', action='store_true', help='Only display error messages')
     parser.add_argument('--show-warnings', action='store_true', help='Display warnings')
 
@@ -309,6 +315,10 @@ def main(tmpDir):
         solcArgs += ' --boogie-mod-analysis'
     if args.event_analysis:
         solcArgs += ' --boogie-event-analysis'
+    if args.boogie_jobs > 1:
+        solcArgs += ' --boogie-jobs %d' % args.boogie_jobs
+    if args.slice:
+        solcArgs += ' --boogie-slice'
     convertCommand = args.solc + ' ' + solcArgs
     if args.verbose:
         print(blueTxt('Solc command: ') + convertCommand)
@@ -48,6 +48,26 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(translate_position)
+{
+	CharStream const source("a\nbc\n\nd", "source");
+
+	BOOST_CHECK(source.translatePositionToLineColumn(0) == std::make_tuple(0, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(1) == std::make_tuple(0, 1));
+	BOOST_CHECK(source.translatePositionToLineColumn(2) == std::make_tuple(1, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(4) == std::make_tuple(1, 2));
+	BOOST_CHECK(source.translatePositionToLineColumn(5) == std::make_tuple(2, 0));
+	BOOST_CHECK(source.translatePositionToLineColumn(6) == std::make_tuple(3, 0));
+	// Past the end
+	BOOST_CHECK(source.translatePositionToLineColumn(100) == std::make_tuple(3, 1));
+
+	BOOST_CHECK_EQUAL(source.lineAtPosition(0), "a");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(1), "a");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(2), "bc");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(5), "");
+	BOOST_CHECK_EQUAL(source.lineAtPosition(7), "d");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the hash-consed Boogie expressions.
+ */
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+#include <libsolidity/boogie/BoogieAstExpr.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace bg = boogie;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(BoogieAstExpr)
+
+BOOST_AUTO_TEST_CASE(equal_factory_calls_share_node)
+{
+	auto x = bg::Expr::id("x");
+	BOOST_CHECK(x == bg::Expr::id("x"));
+	BOOST_CHECK(bg::Expr::intlit(1ul) == bg::Expr::intlit(bigint(1)));
+	BOOST_CHECK(bg::Expr::bvlit(bigint(1), 8) == bg::Expr::bvlit("1", 8));
+	BOOST_CHECK(bg::Expr::true_() == bg::Expr::boollit(true));
+
+	auto e1 = bg::Expr::and_(bg::Expr::lt(x, bg::Expr::intlit(1ul)), bg::Expr::fn("f", x, bg::Expr::id("y")));
+	auto e2 = bg::Expr::and_(bg::Expr::lt(bg::Expr::id("x"), bg::Expr::intlit(1ul)), bg::Expr::fn("f", x, bg::Expr::id("y")));
+	BOOST_CHECK(e1 == e2);
+	BOOST_CHECK(bg::Expr::old(e1) == bg::Expr::old(e2));
+	BOOST_CHECK(bg::Expr::arrupd(x, e1, x) == bg::Expr::arrupd(x, e2, x));
+
+	// Substitution goes through the factories as well
+	auto substituted = bg::Expr::plus(x, bg::Expr::id("z"))->substitute({{"z", bg::Expr::id("y")}});
+	BOOST_CHECK(substituted == bg::Expr::plus(x, bg::Expr::id("y")));
+}
+
+BOOST_AUTO_TEST_CASE(different_expressions_are_not_unified)
+{
+	auto a = bg::Expr::id("a");
+	auto i = bg::Expr::id("i");
+	auto v = bg::Expr::id("v");
+
+	BOOST_CHECK(bg::Expr::id("x") != bg::Expr::id("y"));
+	BOOST_CHECK(bg::Expr::intlit(1ul) != bg::Expr::bvlit(bigint(1), 8));
+	BOOST_CHECK(bg::Expr::bvlit(bigint(1), 8) != bg::Expr::bvlit(bigint(1), 16));
+	BOOST_CHECK(bg::Expr::stringlit("x") != bg::Expr::id("x"));
+	BOOST_CHECK(bg::Expr::lt(a, i) != bg::Expr::gt(a, i));
+	BOOST_CHECK(bg::Expr::minus(a, i) != bg::Expr::minus(i, a));
+	BOOST_CHECK(bg::Expr::not_(a) != bg::Expr::neg(a));
+	BOOST_CHECK(bg::Expr::fn("f", a) != bg::Expr::fn("g", a));
+
+	// Array selects and updates
+	BOOST_CHECK(bg::Expr::arrsel(a, i) != bg::Expr::arrupd(a, i, v));
+	BOOST_CHECK(bg::Expr::arrsel(a, i) != bg::Expr::arrsel(i, a));
+	BOOST_CHECK(bg::Expr::arrupd(a, i, v) != bg::Expr::arrupd(a, v, i));
+
+	// Datatype selects and updates
+	auto intType = bg::Decl::elementarytype("int");
+	auto dt1 = bg::Decl::datatype("S1", {{a, intType}});
+	auto dt2 = bg::Decl::datatype("S2", {{a, intType}});
+	auto constr1 = bg::Decl::function("S1", {{a, intType}}, dt1);
+	auto constr2 = bg::Decl::function("S2", {{a, intType}}, dt2);
+	BOOST_CHECK(bg::Expr::dtsel(v, "a", constr1, dt1) == bg::Expr::dtsel(v, "a", constr1, dt1));
+	BOOST_CHECK(bg::Expr::dtsel(v, "a", constr1, dt1) != bg::Expr::dtupd(v, "a", i, constr1, dt1));
+	BOOST_CHECK(bg::Expr::dtsel(v, "a", constr1, dt1) != bg::Expr::dtsel(v, "b", constr1, dt1));
+	BOOST_CHECK(bg::Expr::dtsel(v, "a", constr1, dt1) != bg::Expr::dtsel(v, "a", constr2, dt2));
+	BOOST_CHECK(bg::Expr::dtupd(v, "a", i, constr1, dt1) != bg::Expr::dtupd(v, "a", a, constr1, dt1));
+	BOOST_CHECK(bg::Expr::dtupd(v, "a", i, constr1, dt1) != bg::Expr::dtupd(v, "a", i, constr2, dt2));
+
+	// Select on an array and on a datatype with the same base
+	BOOST_CHECK(bg::Expr::arrsel(v, a) != bg::Expr::dtsel(v, "a", constr1, dt1));
+}
+
+BOOST_AUTO_TEST_CASE(comparison_orders_unequal_expressions)
+{
+	auto x = bg::Expr::id("x");
+	auto y = bg::Expr::id("y");
+	BOOST_CHECK_EQUAL(bg::Expr::cmp(x, bg::Expr::id("x")), 0);
+	BOOST_CHECK(bg::Expr::cmp(x, y) < 0);
+	BOOST_CHECK(bg::Expr::cmp(y, x) > 0);
+
+	auto e1 = bg::Expr::plus(x, bg::Expr::intlit(1ul));
+	auto e2 = bg::Expr::plus(x, bg::Expr::intlit(2ul));
+	BOOST_CHECK(bg::Expr::cmp(e1, e2) < 0);
+	BOOST_CHECK(bg::Expr::cmp(e2, e1) > 0);
+	BOOST_CHECK(bg::Expr::cmp(bg::Expr::arrsel(x, y), bg::Expr::arrupd(x, y, y)) != 0);
+
+	// Sets keep one copy of equal expressions, in structural order
+	bg::Expr::RefSet set{e2, e1, bg::Expr::plus(x, bg::Expr::intlit(1ul))};
+	BOOST_REQUIRE_EQUAL(set.size(), 2);
+	BOOST_CHECK(*set.begin() == e1);
+	BOOST_CHECK(*set.rbegin() == e2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
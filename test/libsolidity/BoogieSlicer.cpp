@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for slicing Boogie programs per procedure.
+ */
+
+#include <libsolidity/boogie/BoogieSlicer.h>
+#include <libsolidity/boogie/BoogieAstExpr.h>
+#include <libsolidity/boogie/BoogieAstStmt.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace bg = boogie;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+set<string> declNames(bg::Program& _program)
+{
+	set<string> names;
+	for (auto const& decl: _program.getDeclarations())
+		names.insert(decl->getName());
+	return names;
+}
+
+bg::ProcDeclRef verifiedProcedure(string const& _name, vector<bg::Stmt::Ref> const& _stmts)
+{
+	auto proc = bg::Decl::procedure(_name, {}, {}, {}, {bg::Block::block("", _stmts)});
+	proc->addAttr(bg::Attr::attr("message", "C::" + _name));
+	return proc;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BoogieSlicer)
+
+BOOST_AUTO_TEST_CASE(slice_keeps_dependencies_only)
+{
+	auto intType = bg::Decl::elementarytype("int");
+	auto t = bg::Decl::customtype("T");
+	auto x = bg::Expr::id("x");
+	auto y = bg::Expr::id("y");
+	auto f = bg::Expr::fn("f", bg::Expr::intlit(0ul));
+
+	bg::Program program;
+	auto& decls = program.getDeclarations();
+	decls.push_back(t);
+	decls.push_back(bg::Decl::variable("x", t));
+	decls.push_back(bg::Decl::variable("y", intType));
+	decls.push_back(bg::Decl::function("f", {{bg::Expr::id("n"), intType}}, intType));
+	decls.push_back(bg::Decl::axiom(bg::Expr::eq(f, bg::Expr::intlit(1ul))));
+	decls.push_back(bg::Decl::axiom(bg::Expr::eq(y, bg::Expr::intlit(0ul))));
+	decls.push_back(bg::Decl::comment("c", "x y f"));
+	// Called procedures keep their bodies for the modifies analysis
+	decls.push_back(bg::Decl::procedure("callee", {}, {}, {}, {bg::Block::block("", {bg::Stmt::havoc("x")})}));
+	decls.push_back(verifiedProcedure("g", {bg::Stmt::call("callee"), bg::Stmt::assert_(bg::Expr::eq(f, f))}));
+	decls.push_back(verifiedProcedure("h", {bg::Stmt::assign(y, bg::Expr::intlit(1ul))}));
+
+	bg::ProgramSlicer slicer(program);
+	vector<string> verified;
+	for (auto const& proc: slicer.verifiedProcedures())
+		verified.push_back(proc->getName());
+	BOOST_CHECK((verified == vector<string>{"g", "h"}));
+
+	bg::Program g = slicer.slice("g");
+	BOOST_CHECK((declNames(g) == set<string>{"T", "x", "f", "", "callee", "g"}));
+	BOOST_CHECK_EQUAL(g.getDeclarations().size(), 6);
+	// Declarations keep their original order
+	BOOST_CHECK(g.getDeclarations().front() == t);
+	BOOST_CHECK_EQUAL(g.getDeclarations().back()->getName(), "g");
+
+	bg::Program h = slicer.slice("h");
+	BOOST_CHECK((declNames(h) == set<string>{"y", "", "h"}));
+	BOOST_CHECK_EQUAL(h.getDeclarations().size(), 3);
+
+	BOOST_CHECK(slicer.slice("nonexistent").getDeclarations().empty());
+}
+
+BOOST_AUTO_TEST_CASE(slice_keeps_datatype_constructors)
+{
+	auto intType = bg::Decl::elementarytype("int");
+	auto s = bg::Decl::datatype("S", {{bg::Expr::id("m"), intType}});
+
+	bg::Program program;
+	auto& decls = program.getDeclarations();
+	decls.push_back(s);
+	// The constructor is not referenced, but it is needed for the datatype
+	decls.push_back(bg::Decl::function("S#constr", {{bg::Expr::id("m"), intType}}, s, nullptr, {bg::Attr::attr("constructor")}));
+	decls.push_back(bg::Decl::variable("v", s));
+	decls.push_back(verifiedProcedure("p", {bg::Stmt::havoc("v")}));
+
+	bg::ProgramSlicer slicer(program);
+	bg::Program p = slicer.slice("p");
+	BOOST_CHECK_EQUAL(p.getDeclarations().size(), program.getDeclarations().size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script to benchmark the Boogie translation of a large (50k line) contract.
+#
+# Every function, statement and specification of the translated program gets a
+# {:sourceloc} attribute, so this measures translating source positions to
+# lines and columns.
+#
+# Usage: benchmark_sourceloc.sh [solc binary...]
+# Each given binary is timed on the same input (e.g., a baseline and a new
+# build), the default is the solc binary of the build directory.
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2020 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -e
+
+REPO_ROOT=$(cd $(dirname "$0")/../.. && pwd)
+SOLC_BINARIES=("$@")
+[[ ${#SOLC_BINARIES[@]} -eq 0 ]] && SOLC_BINARIES=("$REPO_ROOT/build/solc/solc")
+
+LINES=50000
+FUNCTION_LINES=10
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# Generate a contract with many small annotated functions
+SOURCE="$WORK_DIR/Large.sol"
+{
+    echo "pragma solidity >=0.5.0;"
+    echo ""
+    echo "/** @notice invariant total >= 0 */"
+    echo "contract Large {"
+    echo "    int total;"
+    for ((i = 0; i < (LINES - 6) / FUNCTION_LINES; i++)); do
+        echo ""
+        echo "    /** @notice postcondition total == __verifier_old_int(total) + x */"
+        echo "    function f$i(int x) public {"
+        echo "        int y = x;"
+        echo "        if (y > 0) {"
+        echo "            total += y;"
+        echo "        } else {"
+        echo "            total = total + y;"
+        echo "        }"
+        echo "    }"
+    done
+    echo "}"
+} > "$SOURCE"
+echo "Input: $(wc -l < "$SOURCE") lines, $(wc -c < "$SOURCE") bytes"
+
+TIMEFORMAT="%R"
+for solc in "${SOLC_BINARIES[@]}"; do
+    out="$WORK_DIR/out"
+    elapsed=$( { time "$solc" --boogie "$SOURCE" -o "$out" --overwrite > /dev/null 2>&1; } 2>&1 )
+    echo "$solc: ${elapsed}s ($(wc -c < "$out/Large.sol.bpl") bytes of Boogie)"
+done
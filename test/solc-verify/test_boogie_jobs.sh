@@ -0,0 +1,58 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script to check that the Boogie translation does not depend on the
+# number of threads used (--boogie-jobs).
+#
+# Usage: test_boogie_jobs.sh [solc binary]
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2020 solidity contributors.
+#------------------------------------------------------------------------------
+
+REPO_ROOT=$(cd $(dirname "$0")/../.. && pwd)
+SOLC="${1:-$REPO_ROOT/build/solc/solc}"
+# Directories with several contracts per file
+TEST_DIRS="test/solc-verify/multicontract test/solc-verify/inheritance"
+# Options of the translation to check with
+TEST_ARGS=("" "--boogie-arith mod-overflow --boogie-mod-analysis --boogie-event-analysis")
+
+FAIL=0
+PASS=0
+
+OUT_SERIAL=$(mktemp)
+OUT_PARALLEL=$(mktemp)
+
+cd "$REPO_ROOT"
+for filename in $(find $TEST_DIRS -name '*.sol' | sort); do
+    for args in "${TEST_ARGS[@]}"; do
+        "$SOLC" --boogie "$filename" $args --boogie-jobs 1 >& "$OUT_SERIAL"
+        "$SOLC" --boogie "$filename" $args --boogie-jobs 4 >& "$OUT_PARALLEL"
+        if diff "$OUT_SERIAL" "$OUT_PARALLEL" > /dev/null; then
+            PASS=$((PASS+1))
+        else
+            echo "$filename [ $args ]: output differs for --boogie-jobs 1 and 4"
+            diff "$OUT_SERIAL" "$OUT_PARALLEL" | head -n 20
+            FAIL=$((FAIL+1))
+        fi
+    done
+done
+
+rm -f "$OUT_SERIAL" "$OUT_PARALLEL"
+
+echo "$PASS passed, $FAIL failed"
+[[ $FAIL -eq 0 ]]
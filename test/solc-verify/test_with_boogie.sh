@@ -30,7 +30,7 @@
 
 REPO_ROOT=$(cd $(dirname "$0")/../.. && pwd)
 SOLCVERIFY_TESTS="test/solc-verify"
-SOLCVERIFY="$REPO_ROOT/build/solc/solc-verify.py"
+SOLCVERIFY="${SOLCVERIFY:-$REPO_ROOT/build/solc/solc-verify.py}"
 
 ## COLORS
 RED=
@@ -0,0 +1,380 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <tools/solcVerify/Verifier.h>
+
+#include <libsolidity/boogie/BoogieAstExpr.h>
+#include <libsolidity/boogie/BoogieSlicer.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/process.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <thread>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::tools;
+
+namespace bg = boogie;
+namespace bp = boost::process;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Result of running a process.
+struct ProcessOutput
+{
+	bool started = false;
+	bool timedOut = false;
+	int exitCode = 0;
+	string output; // Standard output and error
+};
+
+/// Runs a process with a timeout, killing it (and its children, e.g., the solver) on timeout.
+ProcessOutput runProcess(string const& _executable, vector<string> const& _arguments, chrono::seconds _timeout)
+{
+	ProcessOutput result;
+	fs::path executable = _executable;
+	if (!executable.has_parent_path())
+		executable = bp::search_path(_executable);
+	if (executable.empty())
+	{
+		result.output = "Executable not found: " + _executable;
+		return result;
+	}
+
+	fs::path outputFile = fs::temp_directory_path() / fs::unique_path("solc-verify-%%%%-%%%%-%%%%.out");
+	try
+	{
+		bp::group group;
+		bp::child child(executable, bp::args(_arguments), (bp::std_out & bp::std_err) > outputFile, bp::std_in < bp::null, group);
+		result.started = true;
+		// Poll instead of child::wait_for, which does not return reliably on all Boost versions
+		auto deadline = chrono::steady_clock::now() + _timeout;
+		while (child.running())
+		{
+			if (chrono::steady_clock::now() >= deadline)
+			{
+				result.timedOut = true;
+				group.terminate();
+				break;
+			}
+			this_thread::sleep_for(chrono::milliseconds(10));
+		}
+		child.wait();
+		result.exitCode = child.exit_code();
+	}
+	catch (bp::process_error const& _error)
+	{
+		result.output = _error.what();
+	}
+	if (fs::exists(outputFile))
+	{
+		result.output = util::readFileAsString(outputFile.string());
+		fs::remove(outputFile);
+	}
+	return result;
+}
+
+/// Parses a location of the form 'file(line,col): ...' in the output of Boogie.
+optional<size_t> parseBplLine(string const& _outputLine)
+{
+	static regex const location{R"(^(.*)\((\d+),(\d+)\):)"};
+	smatch match;
+	if (!regex_search(_outputLine, match, location))
+		return nullopt;
+	return stoul(match[2]);
+}
+
+}
+
+string VerificationResult::statusToString(Status _status)
+{
+	switch (_status)
+	{
+	case Status::OK: return "OK";
+	case Status::Error: return "ERROR";
+	case Status::Inconclusive: return "INCONCLUSIVE";
+	case Status::Timeout: return "TIMEOUT";
+	case Status::Skipped: return "SKIPPED";
+	case Status::ProcessError: return "UNKNOWN_PROCESS_ERROR";
+	case Status::BoogieError: return "UNKNOWN_BOOGIE_ERROR";
+	}
+	return "";
+}
+
+bool VerificationResult::betterOrEqual(Status _status, Status _other)
+{
+	if (_status == Status::OK || _status == Status::Error)
+		return true;
+	if (_other == Status::OK || _other == Status::Error)
+		return false;
+	if (_status == Status::Inconclusive)
+		return true;
+	if (_other == Status::Inconclusive)
+		return false;
+	return true;
+}
+
+Verifier::Verifier(bg::Program& _program, string _bplFile, Settings _settings, ostream& _log):
+	m_program(_program),
+	m_settings(move(_settings)),
+	m_log(_log)
+{
+	m_printed.file = move(_bplFile);
+}
+
+void Verifier::writeProgram()
+{
+	ofstream file(m_printed.file);
+	m_printed.lines.print(m_program, file);
+	if (!m_settings.slice)
+		return;
+
+	// Slices are printed next to the program as <name>.<procedure>.bpl
+	string prefix = (fs::path(m_printed.file).parent_path() / fs::path(m_printed.file).stem()).string();
+	bg::ProgramSlicer slicer(m_program);
+	for (auto const& procedure: slicer.verifiedProcedures())
+	{
+		bg::Program slice = slicer.slice(procedure->getName());
+		PrintedProgram& printed = m_slices[procedure->getName()];
+		printed.file = prefix + "." + procedure->getName() + ".bpl";
+		ofstream sliceFile(printed.file);
+		printed.lines.print(slice, sliceFile);
+	}
+}
+
+vector<VerificationResult> Verifier::verifyAll()
+{
+	// Functions in the order of the procedures, skipped ones are not verified
+	vector<VerificationResult> results;
+	map<string, size_t> resultIndex;
+	vector<Job> jobs;
+	for (auto const& decl: m_program.getDeclarations())
+	{
+		auto procedure = dynamic_pointer_cast<bg::ProcDecl const>(decl);
+		if (!procedure || procedure->getAttrs().empty())
+			continue;
+
+		string function = "[Unknown function]";
+		bool skipped = false;
+		for (auto const& attr: procedure->getAttrs())
+		{
+			if (attr->getName() == "message")
+				function = attr->getStringValue();
+			else if (attr->getName() == "skipped")
+				skipped = true;
+		}
+
+		if (!resultIndex.count(function))
+		{
+			resultIndex[function] = results.size();
+			results.push_back({function, VerificationResult::Status::OK, {}});
+		}
+		if (skipped)
+			results[resultIndex[function]].status = VerificationResult::Status::Skipped;
+		else
+			for (auto const& solver: m_settings.solvers)
+			{
+				auto slice = m_slices.find(procedure->getName());
+				PrintedProgram const* program = slice == m_slices.end() ? &m_printed : &slice->second;
+				jobs.push_back({procedure.get(), program, function, solver, {function, VerificationResult::Status::OK, {}}});
+			}
+	}
+
+	// Run the jobs on a pool of threads
+	atomic<size_t> nextJob{0};
+	auto worker = [&]() {
+		for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+			verify(jobs[i]);
+	};
+	vector<thread> workers;
+	for (unsigned i = 0; i < max(1u, min<unsigned>(m_settings.jobs, unsigned(jobs.size()))); ++i)
+		workers.emplace_back(worker);
+	for (auto& thread: workers)
+		thread.join();
+
+	// Merge results of the same function, keeping the more conclusive one
+	map<string, bool> hasResult;
+	for (auto& job: jobs)
+	{
+		auto& result = results[resultIndex[job.function]];
+		if (result.status == VerificationResult::Status::Skipped)
+			continue;
+		if (hasResult[job.function] && VerificationResult::betterOrEqual(result.status, job.result.status))
+			continue;
+		result = move(job.result);
+		hasResult[job.function] = true;
+	}
+	return results;
+}
+
+optional<string> Verifier::findSolver(string const& _solver) const
+{
+	if (m_settings.solverBinary)
+		return m_settings.solverBinary;
+	fs::path path = bp::search_path(_solver);
+	if (path.empty())
+		return nullopt;
+	return path.string();
+}
+
+void Verifier::verify(Job& _job)
+{
+	auto solverPath = findSolver(_job.solver);
+	if (!solverPath)
+	{
+		log("Error: cannot find " + _job.solver);
+		_job.result.status = VerificationResult::Status::ProcessError;
+		return;
+	}
+	if (m_settings.verbose)
+		log("Using " + _job.solver + " at " + *solverPath);
+
+	vector<string> arguments(m_settings.boogieCommand.begin() + 1, m_settings.boogieCommand.end());
+	arguments.push_back(_job.program->file);
+	for (auto const& argument: boogieArguments(_job, *solverPath))
+		arguments.push_back(argument);
+	if (m_settings.verbose)
+		log("Verifier command: " + m_settings.boogieCommand.front() + " " + boost::join(arguments, " "));
+
+	ProcessOutput output = runProcess(m_settings.boogieCommand.front(), arguments, m_settings.timeout);
+	if (output.timedOut)
+	{
+		_job.result.status = VerificationResult::Status::Timeout;
+		return;
+	}
+	if (!output.started || output.exitCode != 0)
+	{
+		if (m_settings.verbose)
+			log("Error while running verifier, details:\n----- Verifier output -----\n" + output.output + "\n---------------------------");
+		_job.result.status = VerificationResult::Status::ProcessError;
+		return;
+	}
+	if (output.output.find("Boogie program verifier finished with") == string::npos)
+	{
+		log("Error while running verifier, details:\n" + output.output);
+		_job.result.status = VerificationResult::Status::BoogieError;
+		return;
+	}
+	if (m_settings.verbose)
+		log("----- Verifier output -----\n" + output.output + "\n---------------------------");
+
+	parseBoogieOutput(output.output, _job.program->lines, _job.result);
+}
+
+vector<string> Verifier::boogieArguments(Job const& _job, string const& _solverPath) const
+{
+	string const& procedure = _job.procedure->getName();
+	vector<string> arguments{"/proc:" + procedure, "/doModSetAnalysis", "/errorTrace:0", "/useArrayTheory", "/trace", "/infer:j"};
+	if (m_settings.smtLog)
+		arguments.push_back("/proverLog:" + *m_settings.smtLog + "." + procedure + "." + _job.solver + ".smt2");
+
+	arguments.push_back("/proverOpt:PROVER_PATH=" + _solverPath);
+	if (_job.solver == "cvc4")
+	{
+		arguments.push_back("/proverOpt:SOLVER=CVC4");
+		arguments.push_back("/proverOpt:C:--incremental --produce-models --quiet");
+		if (m_settings.modArithmetic)
+		{
+			arguments.push_back("/proverOpt:C:--decision=justification --no-arrays-eager-index --arrays-eager-lemmas");
+			arguments.push_back("/proverOpt:LOGIC=QF_AUFDTNIA");
+		}
+	}
+	return arguments;
+}
+
+void Verifier::parseBoogieOutput(string const& _output, bg::PrintedLines const& _lines, VerificationResult& _result) const
+{
+	vector<string> lines;
+	boost::split(lines, _output, boost::is_any_of("\n"));
+	lines.erase(remove_if(lines.begin(), lines.end(), [](string const& _line) { return _line.empty(); }), lines.end());
+
+	// Line of the printed program that a line of the output refers to
+	auto related = [](string const& _outputLine, int _offset) -> size_t {
+		auto line = parseBplLine(_outputLine);
+		return line ? size_t(int(*line) + _offset) : 0;
+	};
+	auto addIssue = [&](size_t _locationLine, string const& _message) {
+		VerificationIssue issue = issueAt(_lines, _locationLine).value_or(VerificationIssue{});
+		issue.message = _message;
+		_result.issues.push_back(issue);
+	};
+
+	static regex const verifying{R"(Verifying .* \.\.\.)"};
+	for (size_t i = 0; i + 1 < lines.size(); ++i)
+	{
+		string const& line = lines[i];
+		string const& nextLine = lines[i + 1];
+		if (line.find("This assertion might not hold.") != string::npos)
+			addIssue(related(line, 0), messageAt(_lines, related(line, 0)));
+		if (line.find("A postcondition might not hold on this return path.") != string::npos)
+			addIssue(related(nextLine, 0), messageAt(_lines, related(nextLine, 0)));
+		if (line.find("A precondition for this call might not hold.") != string::npos)
+			addIssue(related(line, -1), messageAt(_lines, related(nextLine, 0)));
+		if (line.find("Verification inconclusive") != string::npos)
+			addIssue(related(line, 0), "Inconclusive result");
+		if (line.find("This loop invariant might not hold on entry.") != string::npos)
+			addIssue(related(line, 0), "Invariant '" + messageAt(_lines, related(line, 0)) + "' might not hold on loop entry");
+		if (line.find("This loop invariant might not be maintained by the loop.") != string::npos)
+			addIssue(related(line, 0), "Invariant '" + messageAt(_lines, related(line, 0)) + "' might not be maintained by the loop");
+		if (regex_search(line, verifying))
+		{
+			if (nextLine.find("error") != string::npos)
+				_result.status = VerificationResult::Status::Error;
+			else if (nextLine.find("timeout") != string::npos)
+				_result.status = VerificationResult::Status::Timeout;
+			else if (nextLine.find("inconclusive") != string::npos)
+				_result.status = VerificationResult::Status::Inconclusive;
+			else
+				_result.status = VerificationResult::Status::OK;
+		}
+	}
+}
+
+optional<VerificationIssue> Verifier::issueAt(bg::PrintedLines const& _lines, size_t _line)
+{
+	auto sourceloc = _lines.attrAt(_line, "sourceloc");
+	if (!sourceloc || sourceloc->getVals().size() != 3)
+		return nullopt;
+	VerificationIssue issue;
+	issue.file = sourceloc->getStringValue();
+	issue.line = int(dynamic_pointer_cast<bg::IntLit const>(sourceloc->getVals()[1])->getVal());
+	issue.column = int(dynamic_pointer_cast<bg::IntLit const>(sourceloc->getVals()[2])->getVal());
+	return issue;
+}
+
+string Verifier::messageAt(bg::PrintedLines const& _lines, size_t _line)
+{
+	if (auto message = _lines.attrAt(_line, "message"))
+		return message->getStringValue();
+	return "[No message found for error]";
+}
+
+void Verifier::log(string const& _message)
+{
+	lock_guard<mutex> lock(m_logMutex);
+	m_log << _message << endl;
+}
@@ -0,0 +1,154 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace solidity::tools
+{
+
+/** An issue found by the verifier, mapped back to the Solidity source. */
+struct VerificationIssue
+{
+	std::string file;
+	int line = 0;
+	int column = 0;
+	std::string message;
+};
+
+/** Result of verifying a function. */
+struct VerificationResult
+{
+	enum class Status
+	{
+		OK,
+		Error,
+		Inconclusive,
+		Timeout,
+		Skipped,
+		ProcessError,
+		BoogieError
+	};
+
+	std::string function;
+	Status status = Status::OK;
+	std::vector<VerificationIssue> issues;
+
+	static std::string statusToString(Status _status);
+	/** @returns true if _status is at least as good (conclusive) as _other. */
+	static bool betterOrEqual(Status _status, Status _other);
+};
+
+/**
+ * Verifies the procedures of a Boogie program that is kept in memory. The program
+ * is printed once, then each procedure is checked by a separate Boogie process for
+ * each solver, running on a pool of threads. Results are mapped back to the source
+ * using the attributes recorded while printing the program.
+ */
+class Verifier
+{
+public:
+	struct Settings
+	{
+		std::vector<std::string> boogieCommand{"boogie"}; // Boogie executable and its arguments
+		std::vector<std::string> solvers{"z3", "cvc4"};
+		std::optional<std::string> solverBinary; // Overrides the solver found in the PATH
+		bool modArithmetic = false; // Modular arithmetic encoding (solver options depend on it)
+		std::chrono::seconds timeout{10};
+		unsigned jobs = 1;
+		std::optional<std::string> smtLog; // Prefix of the SMT log files
+		bool slice = false; // Verify each procedure in a program with only the declarations it needs
+		bool verbose = false;
+	};
+
+	/**
+	 * @param _program The program to verify
+	 * @param _bplFile Path where the program is printed
+	 * @param _settings Settings of the verifier
+	 * @param _log Stream for verbose output and error messages
+	 */
+	Verifier(boogie::Program& _program, std::string _bplFile, Settings _settings, std::ostream& _log);
+
+	/**
+	 * Prints the program into the .bpl file and records the attributes of the lines.
+	 * If slicing is enabled, the slice of each procedure is printed to a separate file.
+	 */
+	void writeProgram();
+
+	/**
+	 * Verifies all procedures with all solvers. Results for the same function are
+	 * merged, keeping the most conclusive one.
+	 * @returns The results in the order of the functions in the program
+	 */
+	std::vector<VerificationResult> verifyAll();
+
+	/** @returns the path of the solver, or nullopt if it is not found */
+	std::optional<std::string> findSolver(std::string const& _solver) const;
+
+private:
+	/** A program printed into a file, with the attributes of its lines. */
+	struct PrintedProgram
+	{
+		std::string file;
+		boogie::PrintedLines lines;
+	};
+
+	/** A procedure to be checked by a solver. */
+	struct Job
+	{
+		boogie::ProcDecl const* procedure;
+		PrintedProgram const* program; // Program containing the procedure
+		std::string function;
+		std::string solver;
+		VerificationResult result;
+	};
+
+	/** Runs Boogie on a single job. */
+	void verify(Job& _job);
+
+	/** Arguments for Boogie to check a procedure with a solver. */
+	std::vector<std::string> boogieArguments(Job const& _job, std::string const& _solverPath) const;
+
+	/** Maps the output of Boogie back to the source using the recorded attributes. */
+	void parseBoogieOutput(std::string const& _output, boogie::PrintedLines const& _lines, VerificationResult& _result) const;
+
+	/** @returns the location of an attributed line of a printed program */
+	static std::optional<VerificationIssue> issueAt(boogie::PrintedLines const& _lines, size_t _line);
+	/** @returns the message attribute of an attributed line of a printed program */
+	static std::string messageAt(boogie::PrintedLines const& _lines, size_t _line);
+
+	void log(std::string const& _message);
+
+	boogie::Program& m_program;
+	Settings m_settings;
+	std::ostream& m_log;
+	std::mutex m_logMutex;
+	PrintedProgram m_printed;
+	std::map<std::string, PrintedProgram> m_slices; // Printed slice of each procedure (if enabled)
+};
+
+}
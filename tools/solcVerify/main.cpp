@@ -0,0 +1,360 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Verifies Solidity smart contracts: translates them to Boogie in memory and checks
+ * each function with Boogie, without going through solc and solc-verify.py.
+ */
+
+#include <tools/solcVerify/Verifier.h>
+
+#include <libsolidity/boogie/BoogieTranslator.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ReadFile.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+#include <liblangutil/SourceReferenceFormatterHuman.h>
+#include <libsolutil/AnsiColorized.h>
+#include <libsolutil/CommonIO.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::tools;
+using namespace solidity::util::formatting;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+// Exit codes (same as solc-verify.py)
+int constexpr ErrorNoError = 0;
+int constexpr ErrorCompiler = -1;
+int constexpr ErrorSolverNotFound = -2;
+int constexpr ErrorVerification = -6;
+int constexpr ErrorPartial = -7;
+
+bool const coloredOutput = isatty(STDOUT_FILENO);
+
+/// Prints a text in color if standard output is a terminal.
+void printColored(string const& _text, char const* _color)
+{
+	util::AnsiColorized(cout, coloredOutput, {_color}) << _text;
+}
+
+/// Prints the warnings (and errors inside functions) of the compiler and the translator
+/// in the format of solc-verify.py. @returns the number of warnings.
+size_t printWarnings(string const& _output, bool _show)
+{
+	vector<string> lines;
+	boost::split(lines, _output, boost::is_any_of("\n"));
+	lines.emplace_back(); // Source location of a warning is in the next line
+	size_t warnings = 0;
+	for (size_t i = 0; i + 1 < lines.size(); ++i)
+	{
+		string line = lines[i];
+		string nextLine = boost::trim_left_copy(lines[i + 1]);
+		// Ignore pre-release warnings
+		if (line == "Warning: This is a pre-release compiler version, please do not use it in production.")
+			continue;
+		bool compilerWarning = line.find("Warning: ") != string::npos;
+		bool verifierWarning = line.find("solc-verify warning: ") != string::npos;
+		bool verifierError = line.find("solc-verify error: ") != string::npos;
+		if (compilerWarning || verifierWarning)
+			warnings++;
+		if (!_show || !(compilerWarning || verifierWarning || verifierError))
+			continue;
+		if (compilerWarning && boost::starts_with(nextLine, "--> "))
+			line = nextLine.substr(4) + " " + line;
+		for (string kind: {"solc-verify warning", "solc-verify error", "Warning"})
+		{
+			size_t pos = line.find(kind + ": ");
+			if (pos == string::npos)
+				continue;
+			cout << line.substr(0, pos);
+			printColored(kind, kind == "solc-verify error" ? RED : YELLOW);
+			cout << line.substr(pos + kind.size()) << endl;
+			break;
+		}
+	}
+	return warnings;
+}
+
+/// Reads files imported by the sources (relative to the current directory).
+ReadCallback::Callback fileReader()
+{
+	return [](string const& _kind, string const& _path)
+	{
+		try
+		{
+			if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+				return ReadCallback::Result{false, "Unsupported callback kind: " + _kind};
+			if (!fs::exists(_path))
+				return ReadCallback::Result{false, "File not found."};
+			if (!fs::is_regular_file(_path))
+				return ReadCallback::Result{false, "Not a valid file."};
+			return ReadCallback::Result{true, util::readFileAsString(_path)};
+		}
+		catch (...)
+		{
+			return ReadCallback::Result{false, "Exception in read callback: " + boost::current_exception_diagnostic_information()};
+		}
+	};
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solc-verify, verifier for Solidity smart contracts.
+
+Usage: solc-verify [Options] file.sol
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("help", "Show this help screen.")
+		("timeout", po::value<unsigned>()->default_value(10), "Timeout (per function) for running Boogie (in seconds)")
+		("arithmetic", po::value<string>()->default_value("int"), "Encoding used for arithmetic data types and operations in the verifier (int, bv, mod, mod-overflow)")
+		("modifies-analysis", "Perform modification analysis on state variables")
+		("event-analysis", "Perform analysis on emitted events and data changes")
+		("parallel", po::value<unsigned>()->default_value(max(1u, thread::hardware_concurrency())), "How many functions to verify in parallel")
+		("boogie-jobs", po::value<unsigned>()->default_value(1), "How many threads to use to translate contracts to Boogie")
+		("output", po::value<string>(), "Output directory for the Boogie program")
+		("verbose", "Print all output of the compiler and the verifier")
+		("smt-log", po::value<string>(), "Log input for the SMT solver")
+		("slice", "Verify each function in a separate Boogie program containing only the declarations it depends on")
+		("errors-only", "Only display error messages")
+		("show-warnings", "Display warnings")
+		("boogie", po::value<string>()->default_value("boogie"), "Boogie verifier binary to use")
+		("solver", po::value<string>()->default_value("all"), "SMT solver used by the verifier (all, z3, cvc4)")
+		("solver-bin", po::value<string>(), "Override the binary of the solver to use");
+	po::options_description allOptions = options;
+	allOptions.add_options()("input-file", po::value<string>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", 1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(allOptions).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	string const solFile = arguments["input-file"].as<string>();
+	bool const verbose = arguments.count("verbose");
+	bool const showWarnings = arguments.count("show-warnings");
+
+	BoogieTranslator::Settings translatorSettings;
+	string const arithmetic = arguments["arithmetic"].as<string>();
+	if (arithmetic == "int")
+		translatorSettings.encoding = BoogieContext::Encoding::INT;
+	else if (arithmetic == "bv")
+		translatorSettings.encoding = BoogieContext::Encoding::BV;
+	else if (arithmetic == "mod" || arithmetic == "mod-overflow")
+	{
+		translatorSettings.encoding = BoogieContext::Encoding::MOD;
+		translatorSettings.overflow = arithmetic == "mod-overflow";
+	}
+	else
+	{
+		cerr << "Invalid arithmetic encoding: " << arithmetic << endl;
+		return 1;
+	}
+	translatorSettings.modAnalysis = arguments.count("modifies-analysis");
+	translatorSettings.eventAnalysis = arguments.count("event-analysis");
+	translatorSettings.jobs = arguments["boogie-jobs"].as<unsigned>();
+
+	Verifier::Settings verifierSettings;
+	boost::split(verifierSettings.boogieCommand, boost::trim_copy(arguments["boogie"].as<string>()), boost::is_space(), boost::token_compress_on);
+	string const solver = arguments["solver"].as<string>();
+	if (solver == "z3" || solver == "cvc4")
+		verifierSettings.solvers = {solver};
+	else if (solver != "all")
+	{
+		cerr << "Invalid solver: " << solver << endl;
+		return 1;
+	}
+	if (arguments.count("solver-bin"))
+		verifierSettings.solverBinary = arguments["solver-bin"].as<string>();
+	verifierSettings.modArithmetic = translatorSettings.encoding == BoogieContext::Encoding::MOD;
+	verifierSettings.timeout = chrono::seconds(arguments["timeout"].as<unsigned>());
+	verifierSettings.jobs = arguments["parallel"].as<unsigned>();
+	if (arguments.count("smt-log"))
+		verifierSettings.smtLog = arguments["smt-log"].as<string>();
+	verifierSettings.slice = arguments.count("slice");
+	verifierSettings.verbose = verbose;
+
+	// Compile and translate, collecting the diagnostics like solc would print them
+	if (!fs::is_regular_file(solFile))
+	{
+		cerr << solFile << " is not found." << endl;
+		return ErrorCompiler;
+	}
+	CompilerStack compiler(fileReader());
+	compiler.setSources({{fs::path(solFile).generic_string(), util::readFileAsString(solFile)}});
+	stringstream compilerOutput;
+	SourceReferenceFormatterHuman formatter(compilerOutput, false, false);
+	ErrorList translationErrors;
+	ErrorReporter errorReporter(translationErrors);
+	unique_ptr<BoogieTranslator> translator;
+	bool translated = false;
+	try
+	{
+		bool analyzed = compiler.parseAndAnalyze(CompilerStack::State::AnalysisPerformed);
+		for (auto const& error: compiler.errors())
+			formatter.printErrorInformation(*error);
+		if (analyzed)
+		{
+			// Same headers as solc, as they appear in the details of errors
+			compilerOutput << endl << "======= Converting to Boogie IVL =======" << endl;
+			translator = make_unique<BoogieTranslator>(compiler, compiler.sourceNames(), translatorSettings, errorReporter);
+			translator->context().setErrorOut(compilerOutput);
+			if (translator->prepare())
+				for (auto const& sourceName: compiler.sourceNames())
+				{
+					compilerOutput << endl << "======= " << sourceName << " =======" << endl;
+					translator->translate(sourceName);
+				}
+			translator->context().printErrors();
+			translated = Error::containsOnlyWarnings(translationErrors);
+		}
+	}
+	catch (CompilerError const& _exception)
+	{
+		SourceReferenceFormatter(compilerOutput).printExceptionInformation(_exception, "solc-verify exception");
+	}
+	catch (InternalCompilerError const& _exception)
+	{
+		SourceReferenceFormatter(compilerOutput).printExceptionInformation(_exception, "solc-verify internal exception");
+		compilerOutput << "Details:" << endl << boost::diagnostic_information(_exception);
+	}
+
+	if (!translated)
+	{
+		printColored("Error while running compiler, details:", YELLOW);
+		cout << endl << compilerOutput.str() << endl;
+		return ErrorCompiler;
+	}
+	if (verbose)
+	{
+		printColored("----- Compiler output -----", BLUE);
+		cout << endl << compilerOutput.str() << endl;
+		printColored("---------------------------", BLUE);
+		cout << endl;
+	}
+	size_t warnings = printWarnings(compilerOutput.str(), showWarnings);
+
+	// Print the program if requested, otherwise into a temporary directory
+	fs::path outDir = arguments.count("output") ?
+		fs::path(arguments["output"].as<string>()) :
+		fs::temp_directory_path() / fs::unique_path("solc-verify-%%%%-%%%%-%%%%");
+	fs::create_directories(outDir);
+	string bplFile = (outDir / (fs::path(solFile).filename().string() + ".bpl")).string();
+
+	Verifier verifier(translator->context().program(), bplFile, verifierSettings, cout);
+	for (auto const& solverName: verifierSettings.solvers)
+		if (!verifier.findSolver(solverName))
+		{
+			printColored("Error: cannot find " + solverName, YELLOW);
+			cout << endl;
+			return ErrorSolverNotFound;
+		}
+	verifier.writeProgram();
+	vector<VerificationResult> results = verifier.verifyAll();
+	if (!arguments.count("output"))
+		fs::remove_all(outDir);
+
+	// Print the results
+	size_t errors = 0;
+	size_t inconclusive = 0;
+	size_t skipped = 0;
+	string prefix = arguments.count("errors-only") ? "" : " - ";
+	for (auto const& result: results)
+	{
+		char const* color = YELLOW;
+		switch (result.status)
+		{
+		case VerificationResult::Status::OK: color = GREEN; break;
+		case VerificationResult::Status::Error: errors++; color = RED; break;
+		case VerificationResult::Status::Inconclusive: inconclusive++; break;
+		case VerificationResult::Status::Timeout: inconclusive++; break;
+		case VerificationResult::Status::Skipped: skipped++; break;
+		case VerificationResult::Status::ProcessError: color = RED; break;
+		case VerificationResult::Status::BoogieError: color = RED; break;
+		}
+		cout << result.function << ": ";
+		printColored(VerificationResult::statusToString(result.status), color);
+		cout << endl;
+		for (auto const& issue: result.issues)
+			cout << prefix << issue.file << ":" << issue.line << ":" << issue.column << ": " << issue.message << endl;
+	}
+
+	if (warnings > 0 && !showWarnings)
+	{
+		printColored("Use --show-warnings to see " + to_string(warnings) + " warning" + (warnings == 1 ? "" : "s") + ".", YELLOW);
+		cout << endl;
+	}
+	if (inconclusive > 0)
+	{
+		printColored("Inconclusive results.", YELLOW);
+		cout << endl;
+	}
+	if (skipped > 0 && !showWarnings)
+	{
+		printColored("Some functions were skipped. Use --show-warnings to see details.", YELLOW);
+		cout << endl;
+	}
+
+	if (errors > 0)
+	{
+		printColored("Errors were found by the verifier.", RED);
+		cout << endl;
+		return ErrorVerification;
+	}
+	printColored("No errors found.", GREEN);
+	cout << endl;
+	return inconclusive > 0 || skipped > 0 ? ErrorPartial : ErrorNoError;
+}